@@ -0,0 +1,45 @@
+#include <cassert>
+#include "accumulator.h"
+
+TinyFloat Accumulator::result() const {
+    if (nan || (plus_inf && minus_inf))
+        return TinyFloat::nan();
+    if (plus_inf || minus_inf)
+        return TinyFloat::inf(minus_inf);
+
+    uint32_t magnitude[size];
+    bool negative = limbs[size-1] >> 31;
+    uint32_t carry = negative;               // -x = ~x + 1
+    for (int i=0; i<size; i++) {
+        uint32_t limb = negative ? ~limbs[i] : limbs[i];
+        magnitude[i] = limb + carry;
+        carry &= !magnitude[i];
+    }
+
+    int top = size - 1;
+    while (top >= 0 && !magnitude[top]) top--;
+    if (top < 0)                             // an exact zero
+        return TinyFloat::zero(zero_sign < 0);
+
+    uint64_t window = uint64_t(magnitude[top]) << 32 | (top ? magnitude[top-1] : 0); // at least 33 significant bits
+    bool sticky = window % 4;
+    for (int i=0; i<top-1; i++)
+        sticky |= magnitude[i] != 0;
+    return round_to_tinyfloat(negative, 32 * (top - 1) + 2 - offset, (window >> 2) | sticky);
+}
+
+TinyFloat exact_sum(std::span<const TinyFloat> a) {
+    Accumulator acc;
+    for (const TinyFloat& x : a)
+        acc.add(x);
+    return acc.result();
+}
+
+TinyFloat exact_dot(std::span<const TinyFloat> a, std::span<const TinyFloat> b) {
+    assert(a.size() == b.size());
+    Accumulator acc;
+    for (size_t i=0; i<a.size(); i++)
+        acc.add_product(a[i], b[i]);
+    return acc.result();
+}
+
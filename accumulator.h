@@ -0,0 +1,87 @@
+#pragma once
+#include <span>
+#include "tinyfloat.h"
+
+// Exact sums of TinyFloats and of their products: a two's complement fixed-point number wide enough for any product
+// (2^-298 ... 2^256) with 85 bits of headroom, so nothing is rounded until result(). The value does not depend on
+// the order of the additions, and partial accumulators (one per thread, one per chunk) can be merged, so the rounded
+// sum is bit-reproducible whatever the split.
+struct Accumulator {
+    static constexpr int size   = 20;        // 32-bit limbs, 640 bits
+    static constexpr int offset = 298;       // the weight of bit 0 is 2^-298, the smallest product of two subnormals
+    uint32_t limbs[size] = {};               // little-endian, two's complement
+    bool nan = false, plus_inf = false, minus_inf = false;
+    int zero_sign = 0;                       // 0 when empty, -1 if every term was -0, 1 otherwise: x + -x is +0
+
+    constexpr void add(const TinyFloat& x);                          // exact
+    constexpr void add_product(const TinyFloat& a, const TinyFloat& b); // a*b added exactly, not rounded
+    constexpr void merge(const Accumulator& other);                  // the sum of both, exact
+    TinyFloat result() const;                                        // rounded once, round-to-nearest, even-on-ties
+
+    constexpr void add(bool negative, uint64_t mantissa, int position); // mantissa * 2^(position - offset), mantissa < 2^48
+    constexpr void zero_term(bool negative) { zero_sign = negative && zero_sign <= 0 ? -1 : 1; }
+};
+
+TinyFloat exact_sum(std::span<const TinyFloat> a);                             // the sum rounded once
+TinyFloat exact_dot(std::span<const TinyFloat> a, std::span<const TinyFloat> b); // the dot product rounded once
+
+constexpr void Accumulator::add(bool negative, uint64_t mantissa, int position) {
+    int i = position / 32, s = position % 32;
+    uint32_t part[3] = { uint32_t(mantissa << s), uint32_t((mantissa << s) >> 32), uint32_t(s ? mantissa >> (64 - s) : 0) };
+    int64_t carry = 0;                       // -1, 0 or 1
+    for (int k=0; k<3; k++, i++) {
+        int64_t t = int64_t(limbs[i]) + (negative ? -int64_t(part[k]) : int64_t(part[k])) + carry;
+        limbs[i] = uint32_t(t);
+        carry = t >> 32;
+    }
+    for (; carry && i < size; i++) {         // ripple, wraps around harmlessly at the top
+        int64_t t = int64_t(limbs[i]) + carry;
+        limbs[i] = uint32_t(t);
+        carry = t >> 32;
+    }
+}
+
+constexpr void Accumulator::add(const TinyFloat& x) {
+    if (x.isnan())
+        nan = true;
+    else if (x.isinf())
+        (x.negative ? minus_inf : plus_inf) = true;
+    else if (!x.mantissa)
+        zero_term(x.negative);
+    else {
+        zero_term(false);
+        add(x.negative, x.mantissa, x.exponent - 23 + offset);
+    }
+}
+
+constexpr void Accumulator::add_product(const TinyFloat& a, const TinyFloat& b) {
+    bool negative = a.negative != b.negative;
+    if (a.isnan() || b.isnan())
+        nan = true;
+    else if (a.isinf() || b.isinf()) {
+        if ((a.isfinite() && !a.mantissa) || (b.isfinite() && !b.mantissa))
+            nan = true;                      // 0 * inf
+        else
+            (negative ? minus_inf : plus_inf) = true;
+    } else if (!a.mantissa || !b.mantissa)
+        zero_term(negative);
+    else {
+        zero_term(false);
+        add(negative, uint64_t(a.mantissa) * b.mantissa, a.exponent + b.exponent - 46 + offset);
+    }
+}
+
+constexpr void Accumulator::merge(const Accumulator& other) {
+    int64_t carry = 0;
+    for (int i=0; i<size; i++) {
+        int64_t t = int64_t(limbs[i]) + int64_t(other.limbs[i]) + carry;
+        limbs[i] = uint32_t(t);
+        carry = t >> 32;
+    }
+    nan |= other.nan;
+    plus_inf |= other.plus_inf;
+    minus_inf |= other.minus_inf;
+    if (other.zero_sign)
+        zero_term(other.zero_sign < 0);
+}
+
@@ -0,0 +1,251 @@
+#include <cassert>
+#include <cstring>
+#include "batch.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SIMD
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SIMD
+#endif
+
+template <typename Op>
+static void apply(std::span<const TinyFloat> a, std::span<const TinyFloat> b, std::span<TinyFloat> out, Op op) {
+    assert(a.size() == b.size() && a.size() == out.size());
+    for (size_t i=0; i<out.size(); i++)
+        out[i] = op(a[i], b[i]);
+}
+
+void add(std::span<const TinyFloat> a, std::span<const TinyFloat> b, std::span<TinyFloat> out) {
+    apply(a, b, out, [](const TinyFloat& x, const TinyFloat& y) { return x + y; });
+}
+
+void sub(std::span<const TinyFloat> a, std::span<const TinyFloat> b, std::span<TinyFloat> out) {
+    apply(a, b, out, [](const TinyFloat& x, const TinyFloat& y) { return x - y; });
+}
+
+void mul(std::span<const TinyFloat> a, std::span<const TinyFloat> b, std::span<TinyFloat> out) {
+    apply(a, b, out, [](const TinyFloat& x, const TinyFloat& y) { return x * y; });
+}
+
+void div(std::span<const TinyFloat> a, std::span<const TinyFloat> b, std::span<TinyFloat> out) {
+    apply(a, b, out, [](const TinyFloat& x, const TinyFloat& y) { return x / y; });
+}
+
+void neg(std::span<const TinyFloat> a, std::span<TinyFloat> out) {
+    assert(a.size() == out.size());
+    for (size_t i=0; i<out.size(); i++)
+        out[i] = -a[i];
+}
+
+void div(std::span<const TinyFloat> a, const TinyFloatDivisor& d, std::span<TinyFloat> out) {
+    assert(a.size() == out.size());
+    for (size_t i=0; i<out.size(); i++)
+        out[i] = a[i] / d;
+}
+
+// The SIMD kernels work directly on the IEEE bit layout of PackedFloat.
+// Each kernel computes a block of lanes and returns a bitmask of the lanes it could not handle.
+
+#if defined(__AVX2__)
+
+constexpr int lanes = 8;
+using vec = __m256i;
+
+static vec load(const PackedFloat* p) { return _mm256_loadu_si256(reinterpret_cast<const vec*>(p)); }
+static void store(uint32_t* p, vec v) { _mm256_storeu_si256(reinterpret_cast<vec*>(p), v); }
+static vec set1(uint32_t x) { return _mm256_set1_epi32(x); }
+static vec and_(vec x, vec y) { return _mm256_and_si256(x, y); }
+static vec or_(vec x, vec y) { return _mm256_or_si256(x, y); }
+static vec xor_(vec x, vec y) { return _mm256_xor_si256(x, y); }
+static vec andnot(vec x, vec y) { return _mm256_andnot_si256(x, y); }
+static vec add32(vec x, vec y) { return _mm256_add_epi32(x, y); }
+static vec sub32(vec x, vec y) { return _mm256_sub_epi32(x, y); }
+static vec gt32(vec x, vec y) { return _mm256_cmpgt_epi32(x, y); }
+static vec add64(vec x, vec y) { return _mm256_add_epi64(x, y); }
+static vec sub64(vec x, vec y) { return _mm256_sub_epi64(x, y); }
+static vec set1_64(uint64_t x) { return _mm256_set1_epi64x(x); }
+static vec mul32x32(vec x, vec y) { return _mm256_mul_epu32(x, y); }
+template <int n> static vec srl32(vec x) { return _mm256_srli_epi32(x, n); }
+template <int n> static vec sll32(vec x) { return _mm256_slli_epi32(x, n); }
+template <int n> static vec srl64(vec x) { return _mm256_srli_epi64(x, n); }
+template <int n> static vec sll64(vec x) { return _mm256_slli_epi64(x, n); }
+static int invalid(vec valid) { return ~_mm256_movemask_ps(_mm256_castsi256_ps(valid)) & 0xFF; }
+
+#elif defined(__SSE2__) || defined(_M_X64)
+
+constexpr int lanes = 4;
+using vec = __m128i;
+
+static vec load(const PackedFloat* p) { return _mm_loadu_si128(reinterpret_cast<const vec*>(p)); }
+static void store(uint32_t* p, vec v) { _mm_storeu_si128(reinterpret_cast<vec*>(p), v); }
+static vec set1(uint32_t x) { return _mm_set1_epi32(x); }
+static vec and_(vec x, vec y) { return _mm_and_si128(x, y); }
+static vec or_(vec x, vec y) { return _mm_or_si128(x, y); }
+static vec xor_(vec x, vec y) { return _mm_xor_si128(x, y); }
+static vec andnot(vec x, vec y) { return _mm_andnot_si128(x, y); }
+static vec add32(vec x, vec y) { return _mm_add_epi32(x, y); }
+static vec sub32(vec x, vec y) { return _mm_sub_epi32(x, y); }
+static vec gt32(vec x, vec y) { return _mm_cmpgt_epi32(x, y); }
+static vec add64(vec x, vec y) { return _mm_add_epi64(x, y); }
+static vec sub64(vec x, vec y) { return _mm_sub_epi64(x, y); }
+static vec set1_64(uint64_t x) { return _mm_set1_epi64x(x); }
+static vec mul32x32(vec x, vec y) { return _mm_mul_epu32(x, y); }
+template <int n> static vec srl32(vec x) { return _mm_srli_epi32(x, n); }
+template <int n> static vec sll32(vec x) { return _mm_slli_epi32(x, n); }
+template <int n> static vec srl64(vec x) { return _mm_srli_epi64(x, n); }
+template <int n> static vec sll64(vec x) { return _mm_slli_epi64(x, n); }
+static int invalid(vec valid) { return ~_mm_movemask_ps(_mm_castsi128_ps(valid)) & 0xF; }
+
+#endif
+
+#ifdef SIMD
+
+static vec between(vec x, uint32_t lo, uint32_t hi) { // lo <= x <= hi, signed comparison
+    return andnot(gt32(set1(lo), x), gt32(set1(hi+1), x));
+}
+
+static vec neg_kernel(vec a) {
+    vec nan = gt32(and_(a, set1(0x7FFFFFFF)), set1(0x7F800000)); // NaNs keep their sign
+    return xor_(a, andnot(nan, set1(0x80000000)));
+}
+
+static vec mul_kernel(vec a, vec b, int& fallback) {
+    vec ea = and_(srl32<23>(a), set1(255));
+    vec eb = and_(srl32<23>(b), set1(255));
+    vec ma = or_(and_(a, set1((1u<<23)-1)), set1(1u<<23));
+    vec mb = or_(and_(b, set1((1u<<23)-1)), set1(1u<<23));
+
+    vec even = mul32x32(ma, mb);                        // 48-bit products of the even lanes
+    vec odd  = mul32x32(srl64<32>(ma), srl64<32>(mb));  // and of the odd lanes, in [2^46, 2^48)
+    vec top_even = srl64<47>(even);                     // 1 if the product is in [2^47, 2^48)
+    vec top_odd  = srl64<47>(odd);
+    even = add64(even, and_(even, sub64(top_even, set1_64(1)))); // normalize to [2^47, 2^48)
+    odd  = add64(odd,  and_(odd,  sub64(top_odd,  set1_64(1))));
+
+    vec mask24 = set1_64((1u<<24)-1);
+    vec m   = or_(srl64<24>(even),  sll64<32>(srl64<24>(odd))); // back to 32-bit lanes
+    vec rem = or_(and_(even, mask24), sll64<32>(and_(odd, mask24)));
+    vec top = or_(top_even, sll64<32>(top_odd));
+
+    vec up = gt32(add32(rem, and_(m, set1(1))), set1(1u<<23)); // round-to-nearest, even-on-ties
+    m = sub32(m, up);
+    vec e = add32(sub32(add32(ea, eb), set1(127)), top);       // biased exponent of the result
+    vec r = add32(sll32<23>(sub32(e, set1(1))), m);            // the carry of the rounding goes to the exponent
+
+    vec valid = and_(and_(between(ea, 1, 254), between(eb, 1, 254)), and_(between(e, 1, 254), gt32(set1(0x7F800000), r)));
+    fallback = invalid(valid);
+    return or_(r, and_(xor_(a, b), set1(0x80000000)));
+}
+
+#endif
+
+#if defined(__AVX2__)
+
+static vec add_kernel(vec a, vec b, int& fallback) {
+    vec absa = and_(a, set1(0x7FFFFFFF));
+    vec absb = and_(b, set1(0x7FFFFFFF));
+    vec swap = gt32(absb, absa);
+    vec big   = _mm256_blendv_epi8(a, b, swap);
+    vec small = _mm256_blendv_epi8(b, a, swap);
+
+    vec ex = srl32<23>(and_(big,   set1(0x7FFFFFFF)));
+    vec ey = srl32<23>(and_(small, set1(0x7FFFFFFF)));
+    vec mx = sll32<3>(or_(and_(big,   set1((1u<<23)-1)), set1(1u<<23))); // reserve place for GRS bits
+    vec my = sll32<3>(or_(and_(small, set1((1u<<23)-1)), set1(1u<<23)));
+
+    vec d = sub32(ex, ey);                                                // align exponents, LSB is sticky
+    vec shifted = _mm256_srlv_epi32(my, d);
+    my = or_(shifted, andnot(_mm256_cmpeq_epi32(_mm256_sllv_epi32(shifted, d), my), set1(1)));
+
+    vec opposite = _mm256_srai_epi32(xor_(a, b), 31);
+    vec s = add32(mx, sub32(xor_(my, opposite), opposite));               // mx + my or mx - my
+
+    vec hi = gt32(s, set1((1u<<27)-1));                                   // at most one bit of carry
+    vec lo = gt32(set1(1u<<26), s);                                       // or one bit of cancellation
+    s = _mm256_blendv_epi8(s, or_(srl32<1>(s), and_(s, set1(1))), hi);
+    s = _mm256_blendv_epi8(s, sll32<1>(s), lo);
+    vec e = add32(sub32(ex, hi), lo);
+
+    vec m = srl32<3>(s);
+    vec g = and_(srl32<2>(s), set1(1));
+    vec up = and_(g, gt32(or_(and_(s, set1(3)), and_(m, set1(1))), set1(0))); // round-to-nearest, even-on-ties
+    vec r = add32(sll32<23>(sub32(e, set1(1))), add32(m, up));
+
+    vec close = andnot(gt32(d, set1(1)), opposite);                       // possible massive cancellation
+    vec valid = and_(and_(between(srl32<23>(absa), 1, 254), between(srl32<23>(absb), 1, 254)),
+                     and_(andnot(close, between(e, 1, 254)), gt32(set1(0x7F800000), r)));
+    fallback = invalid(valid);
+    return or_(r, and_(big, set1(0x80000000)));
+}
+
+static vec sub_kernel(vec a, vec b, int& fallback) {
+    return add_kernel(a, xor_(b, set1(0x80000000)), fallback);
+}
+
+#else
+constexpr std::nullptr_t add_kernel = nullptr; // no variable shifts before AVX2, the scalar operators do the job
+constexpr std::nullptr_t sub_kernel = nullptr;
+#endif
+
+template <auto kernel, typename Op>
+static void apply(std::span<const PackedFloat> a, std::span<const PackedFloat> b, std::span<PackedFloat> out, Op op) {
+    assert(a.size() == b.size() && a.size() == out.size());
+    size_t i = 0;
+#ifdef SIMD
+    if constexpr (kernel != nullptr)
+        for (; i+lanes<=out.size(); i+=lanes) {
+            uint32_t r[lanes];
+            int fallback = 0;
+            store(r, kernel(load(&a[i]), load(&b[i]), fallback));
+            for (int k=0; k<lanes; k++)
+                if (fallback & (1<<k))
+                    r[k] = op(a[i+k], b[i+k]).bits();
+            std::memcpy(&out[i], r, sizeof(r)); // out may alias a or b
+        }
+#endif
+    for (; i<out.size(); i++)
+        out[i] = op(a[i], b[i]);
+}
+
+void add(std::span<const PackedFloat> a, std::span<const PackedFloat> b, std::span<PackedFloat> out) {
+    apply<add_kernel>(a, b, out, [](const TinyFloat& x, const TinyFloat& y) { return x + y; });
+}
+
+void sub(std::span<const PackedFloat> a, std::span<const PackedFloat> b, std::span<PackedFloat> out) {
+    apply<sub_kernel>(a, b, out, [](const TinyFloat& x, const TinyFloat& y) { return x - y; });
+}
+
+void mul(std::span<const PackedFloat> a, std::span<const PackedFloat> b, std::span<PackedFloat> out) {
+#ifdef SIMD
+    apply<mul_kernel>(a, b, out, [](const TinyFloat& x, const TinyFloat& y) { return x * y; });
+#else
+    apply<nullptr>(a, b, out, [](const TinyFloat& x, const TinyFloat& y) { return x * y; });
+#endif
+}
+
+void div(std::span<const PackedFloat> a, std::span<const PackedFloat> b, std::span<PackedFloat> out) {
+    apply<nullptr>(a, b, out, [](const TinyFloat& x, const TinyFloat& y) { return x / y; }); // no integer division in SIMD
+}
+
+void neg(std::span<const PackedFloat> a, std::span<PackedFloat> out) {
+    assert(a.size() == out.size());
+    size_t i = 0;
+#ifdef SIMD
+    for (; i+lanes<=out.size(); i+=lanes) {
+        uint32_t r[lanes];
+        store(r, neg_kernel(load(&a[i])));
+        std::memcpy(&out[i], r, sizeof(r));
+    }
+#endif
+    for (; i<out.size(); i++)
+        out[i] = -TinyFloat(a[i]);
+}
+
+void div(std::span<const PackedFloat> a, const TinyFloatDivisor& d, std::span<PackedFloat> out) {
+    assert(a.size() == out.size());
+    for (size_t i=0; i<out.size(); i++)
+        out[i] = TinyFloat(a[i]) / d;
+}
+
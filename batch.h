@@ -0,0 +1,26 @@
+#pragma once
+#include <span>
+#include "tinyfloat.h"
+#include "packed.h"
+#include "divisor.h"
+
+// Element-wise operations over whole arrays: out[i] = a[i] op b[i].
+// The results are bit-identical to the scalar operators, and out may alias the inputs.
+// On x86 the packed overloads process several values at once with SSE2 (or AVX2 if enabled at compile time):
+// lanes that fall off the fast path (special values, subnormals, overflow, massive cancellation) are
+// handed over to the scalar operators.
+
+void add(std::span<const TinyFloat> a, std::span<const TinyFloat> b, std::span<TinyFloat> out);
+void sub(std::span<const TinyFloat> a, std::span<const TinyFloat> b, std::span<TinyFloat> out);
+void mul(std::span<const TinyFloat> a, std::span<const TinyFloat> b, std::span<TinyFloat> out);
+void div(std::span<const TinyFloat> a, std::span<const TinyFloat> b, std::span<TinyFloat> out);
+void neg(std::span<const TinyFloat> a, std::span<TinyFloat> out);
+void div(std::span<const TinyFloat> a, const TinyFloatDivisor& d, std::span<TinyFloat> out);
+
+void add(std::span<const PackedFloat> a, std::span<const PackedFloat> b, std::span<PackedFloat> out);
+void sub(std::span<const PackedFloat> a, std::span<const PackedFloat> b, std::span<PackedFloat> out);
+void mul(std::span<const PackedFloat> a, std::span<const PackedFloat> b, std::span<PackedFloat> out);
+void div(std::span<const PackedFloat> a, std::span<const PackedFloat> b, std::span<PackedFloat> out);
+void neg(std::span<const PackedFloat> a, std::span<PackedFloat> out);
+void div(std::span<const PackedFloat> a, const TinyFloatDivisor& d, std::span<PackedFloat> out);
+
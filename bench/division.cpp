@@ -0,0 +1,92 @@
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <vector>
+#include "tinyfloat.h"
+
+// Compares operator/ against the restoring bit-at-a-time loop it replaced.
+
+TinyFloat division_loop(const TinyFloat &a, const TinyFloat &b) {
+    bool a_zero = a.isfinite() && !a.mantissa;
+    bool b_zero = b.isfinite() && !b.mantissa;
+    if (a.isnan() || b.isnan() || (a.isinf() && b.isinf()) || (a_zero && b_zero))
+        return TinyFloat::nan();
+
+    bool negative = a.negative != b.negative;
+    if (a.isinf() || b_zero)
+        return TinyFloat::inf(negative);
+
+    if (a_zero || b.isinf())
+        return TinyFloat::zero(negative);
+
+    uint32_t mantissa  = a.mantissa / b.mantissa;
+    uint32_t remainder = a.mantissa % b.mantissa;
+    int16_t  exponent  = a.exponent - b.exponent + 23;
+
+    while (mantissa < (1u<<23) && exponent > -126) { // normalize the result
+        remainder *= 2;
+        mantissa = mantissa * 2 + remainder / b.mantissa;
+        remainder = remainder % b.mantissa;
+        exponent--;
+    }
+
+    while (exponent < -126) {
+        remainder = (remainder + (mantissa % 2)*b.mantissa)/2 | (remainder % 2);   // LSB is sticky
+        mantissa /= 2;
+        exponent++;
+    }
+
+    if (remainder*2 > b.mantissa || (remainder*2 == b.mantissa && mantissa % 2)) { // round-to-nearest, even-on-ties
+        mantissa++;
+        if (mantissa == (1u<<24)) {    // renormalize if necessary
+            mantissa /= 2;
+            exponent++;
+        }
+    }
+
+    if (exponent >= 128)               // handle overflow
+        return TinyFloat::inf(negative);
+
+    return { negative, exponent, mantissa };
+}
+
+template <typename Division>
+double measure(Division division, const std::vector<TinyFloat>& a, const std::vector<TinyFloat>& b, std::vector<TinyFloat>& out) {
+    auto start = std::chrono::steady_clock::now();
+    for (int repeat=0; repeat<10; repeat++)
+        for (size_t i=0; i<a.size(); i++)
+            out[i] = division(a[i], b[i]);
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / (10 * a.size());
+}
+
+int main() {
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<uint32_t> bits;
+    struct { const char* name; uint32_t a_exponent, b_exponent; } classes[] = {
+        { "normal / normal",    127,   127 }, // exponent fields, 0 means random
+        { "random bit pattern",   0,     0 },
+        { "subnormal result",    10,   200 },
+        { "subnormal operands",   1,     1 }
+    };
+
+    for (auto [name, a_exponent, b_exponent] : classes) {
+        std::vector<TinyFloat> a(1<<16), b(1<<16), loop(1<<16), radix(1<<16);
+        for (size_t i=0; i<a.size(); i++) {
+            uint32_t u = bits(gen), v = bits(gen);
+            if (a_exponent) u = (u & 0x807FFFFF) | ((a_exponent - (a_exponent==1)) << 23);
+            if (b_exponent) v = (v & 0x807FFFFF) | ((b_exponent - (b_exponent==1)) << 23);
+            a[i] = TinyFloat::from_bits(u);
+            b[i] = TinyFloat::from_bits(v);
+        }
+        double t_loop  = measure(division_loop, a, b, loop);
+        double t_radix = measure([](const TinyFloat& x, const TinyFloat& y) { return x / y; }, a, b, radix);
+        bool same = true;
+        for (size_t i=0; i<a.size(); i++)
+            same &= loop[i].bits() == radix[i].bits() || (loop[i].isnan() && radix[i].isnan());
+        std::cout << name << ": bit loop " << t_loop << " ns, radix-256 " << t_radix << " ns, speedup " << t_loop / t_radix
+                  << (same ? "" : ", RESULTS DIFFER") << std::endl;
+    }
+    return 0;
+}
+
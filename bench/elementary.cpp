@@ -0,0 +1,80 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "elementary.h"
+
+// Throughput of the elementary functions against a hand-written Taylor series in TinyFloat operators (what lighting
+// and tone-mapping code did before) and against the host libm on hardware floats.
+
+TinyFloat exp_series(const TinyFloat& x) {     // 1 + |x| + |x|^2/2 + ..., 40 terms: the first one dropped at |x| = 10 is 1e-8
+    TinyFloat a = x.negative ? -x : x;         // of the sum; the alternating series for x < 0 would cancel, so take 1/exp(|x|)
+    TinyFloat sum = 1, term = 1;
+    for (int n=1; n<40; n++) {
+        term = term * a / TinyFloat(n);
+        sum = sum + term;
+    }
+    return x.negative ? TinyFloat(1) / sum : sum;
+}
+
+TinyFloat sin_series(const TinyFloat& x) {     // x - x^3/3! + ..., |x| <= pi
+    TinyFloat sum = x, term = x, x2 = x * x;
+    for (int n=1; n<10; n++) {
+        term = -term * x2 / TinyFloat((2*n) * (2*n+1));
+        sum = sum + term;
+    }
+    return sum;
+}
+
+template <typename Function, typename T>
+double measure(Function function, const std::vector<T>& a, const std::vector<T>& b, std::vector<T>& out) {
+    auto start = std::chrono::steady_clock::now();
+    for (int repeat=0; repeat<10; repeat++)
+        for (size_t i=0; i<a.size(); i++)
+            out[i] = function(a[i], b[i]);
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / (10 * a.size());
+}
+
+int main() {
+    std::mt19937 gen(0);
+    struct Case {
+        const char* name;
+        float lo, hi;                           // the range of the first argument, the second one is in [-2, 2]
+        TinyFloat (*tiny)(const TinyFloat&, const TinyFloat&);
+        float (*host)(float, float);
+        TinyFloat (*series)(const TinyFloat&, const TinyFloat&);
+    } cases[] = {
+        { "exp",     -10, 10, [](const TinyFloat& x, const TinyFloat&) { return exp(x); },     [](float x, float) { return std::exp(x); },
+                              [](const TinyFloat& x, const TinyFloat&) { return exp_series(x); } },
+        { "exp2",    -10, 10, [](const TinyFloat& x, const TinyFloat&) { return exp2(x); },    [](float x, float) { return std::exp2(x); }, nullptr },
+        { "log",    1e-3f, 1e3f, [](const TinyFloat& x, const TinyFloat&) { return log(x); },  [](float x, float) { return std::log(x); }, nullptr },
+        { "log2",   1e-3f, 1e3f, [](const TinyFloat& x, const TinyFloat&) { return log2(x); }, [](float x, float) { return std::log2(x); }, nullptr },
+        { "pow",        0, 10, [](const TinyFloat& x, const TinyFloat& y) { return pow(x, y); }, [](float x, float y) { return std::pow(x, y); }, nullptr },
+        { "sin",   -3.14f, 3.14f, [](const TinyFloat& x, const TinyFloat&) { return sin(x); }, [](float x, float) { return std::sin(x); },
+                              [](const TinyFloat& x, const TinyFloat&) { return sin_series(x); } },
+        { "cos",   -3.14f, 3.14f, [](const TinyFloat& x, const TinyFloat&) { return cos(x); }, [](float x, float) { return std::cos(x); }, nullptr },
+        { "tan",   -1.5f, 1.5f, [](const TinyFloat& x, const TinyFloat&) { return tan(x); },   [](float x, float) { return std::tan(x); }, nullptr },
+        { "sin(1e6 range)", -1e6f, 1e6f, [](const TinyFloat& x, const TinyFloat&) { return sin(x); }, [](float x, float) { return std::sin(x); }, nullptr },
+        { "atan2",    -2, 2, [](const TinyFloat& x, const TinyFloat& y) { return atan2(x, y); }, [](float x, float y) { return std::atan2(x, y); }, nullptr }
+    };
+
+    for (const Case& c : cases) {
+        std::uniform_real_distribution<float> first(c.lo, c.hi), second(-2, 2);
+        std::vector<float> a(1<<16), b(1<<16), host(1<<16);
+        std::vector<TinyFloat> ta(1<<16), tb(1<<16), out(1<<16);
+        for (size_t i=0; i<a.size(); i++) {
+            ta[i] = a[i] = first(gen);
+            tb[i] = b[i] = second(gen);
+        }
+        double t_tiny = measure(c.tiny, ta, tb, out);
+        double t_host = measure(c.host, a, b, host);
+        std::cout << c.name << ": elementary " << t_tiny << " ns, host libm " << t_host << " ns";
+        if (c.series)
+            std::cout << ", Taylor series in TinyFloat " << measure(c.series, ta, tb, out) << " ns";
+        std::cout << std::endl;
+    }
+    return 0;
+}
+
@@ -0,0 +1,67 @@
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+#include "linalg.h"
+
+// The blocked kernels against the naive triple loop over PackedFloat, in nanoseconds per multiply-add.
+
+void naive_gemm(int m, int n, int k, const PackedVector& a, const PackedVector& b, PackedVector& c) {
+    for (int i=0; i<m; i++)
+        for (int j=0; j<n; j++) {
+            TinyFloat sum = 0;
+            for (int p=0; p<k; p++)
+                sum = sum + TinyFloat(a[size_t(i) * k + p]) * TinyFloat(b[size_t(p) * n + j]);
+            c[size_t(i) * n + j] = sum;
+        }
+}
+
+template <typename Function>
+double measure(Function function, double multiply_adds) {
+    int repeat = std::max(1, int(2e6 / multiply_adds));
+    auto start = std::chrono::steady_clock::now();
+    for (int r=0; r<repeat; r++)
+        function();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / (repeat * multiply_adds);
+}
+
+int main() {
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<float> values(-1, 1);
+    auto random = [&](size_t size) {
+        PackedVector v(size);
+        for (PackedFloat& x : v) x = TinyFloat(values(gen));
+        return v;
+    };
+
+    for (int size : { 3, 4, 16, 64, 256, 512 }) {
+        PackedVector a = random(size_t(size) * size), b = random(size_t(size) * size), c(a.size()), d(a.size());
+        double n3 = double(size) * size * size;
+        double t_naive   = measure([&] { naive_gemm(size, size, size, a, b, d); }, n3);
+        double t_rounded = measure([&] { gemm(size, size, size, a, b, c); }, n3);
+        bool identical = true;
+        for (size_t i=0; i<c.size(); i++)
+            identical &= c[i].bits == d[i].bits;
+        double t_fused = measure([&] { gemm(size, size, size, a, b, c, Accumulation::fused); }, n3);
+        double t_exact = measure([&] { gemm(size, size, size, a, b, c, Accumulation::exact); }, n3);
+        std::cout << "gemm " << size << "x" << size << ": naive " << t_naive << " ns, blocked " << t_rounded
+                  << " ns" << (identical ? " (bit-identical)" : " (DIFFERENT)") << ", fused " << t_fused << " ns, exact " << t_exact << " ns" << std::endl;
+    }
+
+    int n = 1024;
+    PackedVector a = random(size_t(n) * n), x = random(n), y(n), z(n);
+    double t_naive = measure([&] { naive_gemm(n, 1, n, a, x, z); }, double(n) * n);
+    double t_gemv  = measure([&] { gemv(n, n, a, x, y); }, double(n) * n);
+    std::cout << "gemv " << n << "x" << n << ": naive " << t_naive << " ns, blocked " << t_gemv << " ns" << std::endl;
+
+    PackedVector u = random(1<<16), v = random(1<<16);
+    double t_dot   = measure([&] { z[0] = dot(u, v); }, u.size());
+    double t_dot_f = measure([&] { z[0] = dot(u, v, Accumulation::fused); }, u.size());
+    double t_dot_e = measure([&] { z[0] = dot(u, v, Accumulation::exact); }, u.size());
+    double t_dot_n = measure([&] { naive_gemm(1, 1, int(u.size()), u, v, z); }, u.size());
+    std::cout << "dot 65536: naive " << t_dot_n << " ns, rounded " << t_dot << " ns, fused " << t_dot_f << " ns, exact " << t_dot_e << " ns" << std::endl;
+    return 0;
+}
+
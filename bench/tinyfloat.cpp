@@ -0,0 +1,186 @@
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "tinyfloat.h"
+#include "printer.h"
+
+// Throughput and latency of every operator and conversion against the host float, split by operand class:
+// the loops in operator+, operator* and operator/ depend on the data, so an average over random bits says little.
+// The output is JSON, one record per operation and class, to be tracked across commits:
+//   ./tinyfloat-bench > bench.json
+// Latency is the distribution of the time per operation over batches of 16 independent operations.
+
+struct Data {                                  // the same operands as TinyFloat and as float
+    std::vector<TinyFloat> a, b, c, abs_a;
+    std::vector<float>     fa, fb, fc, abs_fa;
+    std::vector<int32_t>   i32;
+    std::vector<int64_t>   i64;
+};
+
+enum Class { normal, subnormal, gap, cancellation, special, classes };
+const char* class_names[classes] = { "normal", "subnormal", "huge exponent gap", "cancellation", "special values" };
+
+static uint32_t random_special(std::mt19937& gen) {
+    const uint32_t values[] = { 0x00000000, 0x80000000, 0x7f800000, 0xff800000, 0x7fc00000, 0x3f800000, 0x00000001, 0x7f7fffff };
+    return values[gen() % 8];
+}
+
+static Data generate(Class cls, size_t n, std::mt19937& gen) {
+    Data d;
+    for (size_t i=0; i<n; i++) {
+        uint32_t sign = gen() & 0x80000000, mantissa = gen() & 0x7fffff;
+        uint32_t a = sign | (97 + gen() % 61) << 23 | mantissa; // |exponent| <= 30, nothing overflows
+        uint32_t b = (gen() & 0x80000000) | (97 + gen() % 61) << 23 | (gen() & 0x7fffff);
+        uint32_t c = (gen() & 0x80000000) | (97 + gen() % 61) << 23 | (gen() & 0x7fffff);
+        if (cls == subnormal) {
+            a &= 0x807fffff;
+            b &= 0x807fffff;
+            c &= 0x807fffff;
+        } else if (cls == gap) {               // 30 to 60 binades apart
+            uint32_t e = 100 + gen() % 100;
+            a = (a & 0x807fffff) | e << 23;
+            b = (b & 0x807fffff) | (e - 30 - gen() % 31) << 23;
+            c = (c & 0x807fffff) | (e + 30 + gen() % 25) << 23;
+        } else if (cls == cancellation) {      // b is close to -a, c is close to -a*b
+            b = (a ^ 0x80000000) ^ (gen() % 256);
+            float p = std::bit_cast<float>(a) * std::bit_cast<float>(b);
+            c = std::bit_cast<uint32_t>(-p) ^ (gen() % 16);
+        } else if (cls == special) {
+            a = random_special(gen);
+            b = random_special(gen);
+            c = random_special(gen);
+        }
+        d.a.push_back(TinyFloat::from_bits(a));
+        d.b.push_back(TinyFloat::from_bits(b));
+        d.c.push_back(TinyFloat::from_bits(c));
+        d.abs_a.push_back(TinyFloat::from_bits(a & 0x7fffffff));
+        d.fa.push_back(std::bit_cast<float>(a));
+        d.fb.push_back(std::bit_cast<float>(b));
+        d.fc.push_back(std::bit_cast<float>(c));
+        d.abs_fa.push_back(std::bit_cast<float>(a & 0x7fffffff));
+        d.i32.push_back(int32_t(gen()) >> (gen() % 32));
+        d.i64.push_back(int64_t(uint64_t(gen()) << 32 | gen()) >> (gen() % 64));
+    }
+    return d;
+}
+
+static uint32_t sink(const TinyFloat& x) { return x.bits(); }
+static uint32_t sink(float x)   { return std::bit_cast<uint32_t>(x); }
+static uint32_t sink(int64_t x) { return uint32_t(x) ^ uint32_t(x >> 32); }
+static uint32_t sink(bool x)    { return x; }
+
+static int32_t saturate32(float x) { return std::isnan(x) ? 0 : int32_t(std::clamp(x, -0x1p31f, 0x1.fffffep30f)); }
+static int64_t saturate64(float x) { return std::isnan(x) ? 0 : int64_t(std::clamp(x, -0x1p63f, 0x1.fffffep62f)); }
+
+static std::ostringstream text;                // operator<< writes here, it is rewound before every value
+
+template <typename T>
+static uint32_t print(const T& x) {
+    text.seekp(0);
+    text << x;
+    return uint32_t(text.tellp());
+}
+
+struct Case {
+    const char* name;
+    bool by_class;                             // false: the operands are integers, the class does not apply
+    uint32_t (*tiny)(const Data&, size_t);
+    uint32_t (*host)(const Data&, size_t);
+};
+
+const Case cases[] = {
+    { "add",  true, [](const Data& d, size_t i) { return sink(d.a[i] + d.b[i]); },      [](const Data& d, size_t i) { return sink(d.fa[i] + d.fb[i]); } },
+    { "sub",  true, [](const Data& d, size_t i) { return sink(d.a[i] - d.b[i]); },      [](const Data& d, size_t i) { return sink(d.fa[i] - d.fb[i]); } },
+    { "mul",  true, [](const Data& d, size_t i) { return sink(d.a[i] * d.b[i]); },      [](const Data& d, size_t i) { return sink(d.fa[i] * d.fb[i]); } },
+    { "div",  true, [](const Data& d, size_t i) { return sink(d.a[i] / d.b[i]); },      [](const Data& d, size_t i) { return sink(d.fa[i] / d.fb[i]); } },
+    { "fma",  true, [](const Data& d, size_t i) { return sink(fma(d.a[i], d.b[i], d.c[i])); }, [](const Data& d, size_t i) { return sink(std::fma(d.fa[i], d.fb[i], d.fc[i])); } },
+    { "sqrt", true, [](const Data& d, size_t i) { return sink(sqrt(d.abs_a[i])); },     [](const Data& d, size_t i) { return sink(std::sqrt(d.abs_fa[i])); } },
+    { "neg",  true, [](const Data& d, size_t i) { return sink(-d.a[i]); },              [](const Data& d, size_t i) { return sink(-d.fa[i]); } },
+    { "less", true, [](const Data& d, size_t i) { return sink(d.a[i] < d.b[i]); },      [](const Data& d, size_t i) { return sink(d.fa[i] < d.fb[i]); } },
+    { "equal", true, [](const Data& d, size_t i) { return sink(d.a[i] == d.b[i]); },    [](const Data& d, size_t i) { return sink(d.fa[i] == d.fb[i]); } },
+    { "from float", true, [](const Data& d, size_t i) { return sink(TinyFloat(d.fa[i])); }, [](const Data& d, size_t i) { return sink(d.fa[i]); } },
+    { "to float", true, [](const Data& d, size_t i) { return sink(float(d.a[i])); },    [](const Data& d, size_t i) { return sink(d.fa[i]); } },
+    { "to int32", true, [](const Data& d, size_t i) { return sink(int64_t(to_integer<int32_t>(d.a[i]))); }, [](const Data& d, size_t i) { return sink(int64_t(saturate32(d.fa[i]))); } },
+    { "to int64", true, [](const Data& d, size_t i) { return sink(to_integer<int64_t>(d.a[i])); }, [](const Data& d, size_t i) { return sink(saturate64(d.fa[i])); } },
+    { "from int32", false, [](const Data& d, size_t i) { return sink(TinyFloat(d.i32[i])); }, [](const Data& d, size_t i) { return sink(float(d.i32[i])); } },
+    { "from int64", false, [](const Data& d, size_t i) { return sink(TinyFloat(d.i64[i])); }, [](const Data& d, size_t i) { return sink(float(d.i64[i])); } },
+    { "operator<< exact",    true, [](const Data& d, size_t i) { return print(d.a[i]); }, [](const Data& d, size_t i) { return print(d.fa[i]); } },
+    { "operator<< shortest", true, [](const Data& d, size_t i) { text << shortest; uint32_t n = print(d.a[i]); text << exact; return n; },
+                                   [](const Data& d, size_t i) { return print(d.fa[i]); } }
+};
+
+struct Stats {
+    double ops_per_sec, mean, p50, p90, p99, max; // the times are in nanoseconds per operation
+};
+
+static volatile uint32_t sunk;                 // keeps the results alive
+
+static Stats measure(uint32_t (*op)(const Data&, size_t), const Data& d) {
+    using Clock = std::chrono::steady_clock;
+    size_t n = d.a.size();
+    uint32_t s = 0;
+    for (size_t i=0; i<n; i++)                 // warm-up
+        s ^= op(d, i);
+
+    size_t total = 0;                          // throughput: whole passes for at least 20 ms
+    auto start = Clock::now();
+    std::chrono::duration<double, std::nano> elapsed{};
+    do {
+        for (size_t i=0; i<n; i++)
+            s ^= op(d, i);
+        total += n;
+        elapsed = Clock::now() - start;
+    } while (elapsed.count() < 2e7);
+
+    constexpr size_t batch = 16;               // latency: batches timed one by one
+    std::vector<double> samples;
+    for (int pass=0; pass<4; pass++)
+        for (size_t i=0; i+batch<=n; i+=batch) {
+            auto t0 = Clock::now();
+            for (size_t j=i; j<i+batch; j++)
+                s ^= op(d, j);
+            std::chrono::duration<double, std::nano> t = Clock::now() - t0;
+            samples.push_back(t.count() / batch);
+        }
+    std::sort(samples.begin(), samples.end());
+    auto percentile = [&](double p) { return samples[std::min(samples.size() - 1, size_t(p * samples.size()))]; };
+    sunk = sunk ^ s;
+    return { 1e9 * total / elapsed.count(), elapsed.count() / total, percentile(.5), percentile(.9), percentile(.99), samples.back() };
+}
+
+static void write(std::ostream& out, const char* name, const Stats& s) {
+    out << "\"" << name << "\": {\"ops_per_sec\": " << s.ops_per_sec << ", \"ns\": {\"mean\": " << s.mean << ", \"p50\": " << s.p50
+        << ", \"p90\": " << s.p90 << ", \"p99\": " << s.p99 << ", \"max\": " << s.max << "}}";
+}
+
+int main() {
+    std::mt19937 gen(0);
+    std::vector<Data> data;
+    for (int cls=0; cls<classes; cls++)
+        data.push_back(generate(Class(cls), 4096, gen));
+    text << std::setprecision(9);              // the host float prints 9 significant digits, enough to read it back
+
+    std::cout << std::setprecision(4) << "{\n  \"benchmark\": \"tinyfloat\",\n  \"results\": [";
+    bool first = true;
+    for (const Case& c : cases)
+        for (int cls=0; cls<classes; cls++) {
+            if (!c.by_class && cls != normal) continue;
+            Stats tiny = measure(c.tiny, data[cls]), host = measure(c.host, data[cls]);
+            std::cout << (first ? "\n" : ",\n") << "    {\"op\": \"" << c.name << "\", \"class\": \""
+                      << (c.by_class ? class_names[cls] : "random integers") << "\", ";
+            write(std::cout, "tinyfloat", tiny);
+            std::cout << ", ";
+            write(std::cout, "float", host);
+            std::cout << ", \"slowdown\": " << tiny.mean / host.mean << "}";
+            first = false;
+        }
+    std::cout << "\n  ]\n}" << std::endl;
+    return 0;
+}
+
@@ -0,0 +1,55 @@
+#include <iostream>
+#include <iomanip>
+#include "costmodel.h"
+
+const CostTable cortex_m0plus = { "cortex-m0+", 1, 1, 1, 45, 15, 2 }; // __aeabi_uidiv and a software clz
+const CostTable cortex_m3     = { "cortex-m3",  1, 1, 1,  7,  1, 2 }; // udiv takes 2 to 12 cycles
+const CostTable rv32imc       = { "rv32imc",    1, 1, 1, 35, 12, 2 };
+
+static void accumulate(IntegerOps& sum, const IntegerOps& ops) {
+    sum.shift  += ops.shift;
+    sum.add    += ops.add;
+    sum.mul    += ops.mul;
+    sum.div    += ops.div;
+    sum.clz    += ops.clz;
+    sum.branch += ops.branch;
+}
+
+IntegerOps integer_ops(const TinyFloatStats& s) {
+    IntegerOps ops;
+    for (int op=0; op<int(Counted::count); op++)
+        accumulate(ops, s.op[op].ops);
+    return ops;
+}
+
+double estimated_cycles(const IntegerOps& ops, const CostTable& target) {
+    return ops.shift * target.shift + ops.add * target.add + ops.mul * target.mul + ops.div * target.div
+         + ops.clz * target.clz + ops.branch * target.branch;
+}
+
+std::ostream& print_cost_estimate(std::ostream& out, const TinyFloatStats& s, const CostTable& target) {
+    const char* names[int(Counted::count)] = { "add", "mul", "div", "fma", "sqrt", "compare", "convert" };
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << "estimated cycles on " << target.name << '\n' << std::left << std::setw(8) << "op" << std::right
+        << std::setw(14) << "calls" << std::setw(12) << "shift" << std::setw(12) << "add" << std::setw(12) << "mul"
+        << std::setw(12) << "div" << std::setw(12) << "clz" << std::setw(12) << "branch" << std::setw(16) << "cycles"
+        << std::setw(12) << "cycles/call" << '\n';
+    auto line = [&](const char* name, uint64_t calls, const IntegerOps& ops) {
+        double cycles = estimated_cycles(ops, target);
+        out << std::left << std::setw(8) << name << std::right << std::setw(14) << calls << std::setw(12) << ops.shift
+            << std::setw(12) << ops.add << std::setw(12) << ops.mul << std::setw(12) << ops.div << std::setw(12) << ops.clz
+            << std::setw(12) << ops.branch << std::fixed << std::setprecision(0) << std::setw(16) << cycles
+            << std::setprecision(1) << std::setw(12) << (calls ? cycles / calls : 0.) << '\n';
+    };
+    uint64_t calls = 0;
+    for (int op=0; op<int(Counted::count); op++) {
+        line(names[op], s.op[op].calls, s.op[op].ops);
+        calls += s.op[op].calls;
+    }
+    line("total", calls, integer_ops(s));
+    out.flags(flags);
+    out.precision(precision);
+    return out;
+}
+
@@ -0,0 +1,20 @@
+#pragma once
+#include <iosfwd>
+#include "stats.h"
+
+// Estimated cost of the operators on targets without an FPU, from the tally of integer primitives that the operators
+// keep in stats.h as they execute (cmake -DTINYFLOAT_STATS=ON): a table of cycles per primitive turns the tally
+// into cycles.
+struct CostTable {             // cycles per primitive
+    const char* name;
+    double shift, add, mul, div, clz, branch;
+};
+
+extern const CostTable cortex_m0plus; // no divider, no clz, single-cycle multiplier
+extern const CostTable cortex_m3;     // hardware divider, clz
+extern const CostTable rv32imc;       // serial divider, no clz (no Zbb)
+
+IntegerOps integer_ops(const TinyFloatStats& s);              // all the operators
+double estimated_cycles(const IntegerOps& ops, const CostTable& target);
+std::ostream& print_cost_estimate(std::ostream& out, const TinyFloatStats& s, const CostTable& target); // one line per operator
+
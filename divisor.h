@@ -0,0 +1,70 @@
+#pragma once
+#include "tinyfloat.h"
+
+// Repeated division by the same value: the divisor is normalized once and its reciprocal is precomputed,
+// so the 24 quotient bits cost a multiplication and a correction instead of hardware divisions.
+// The results are bit-identical to operator/.
+struct TinyFloatDivisor {
+    TinyFloat divisor;
+    int      exponent   = 0; // exponent of the normalized divisor
+    uint32_t mantissa   = 0; // normalized mantissa of the divisor, [2^23, 2^24)
+    uint32_t reciprocal = 0; // floor((2^55-1) / mantissa), fits in 32 bits
+
+    explicit constexpr TinyFloatDivisor(const TinyFloat& d) : divisor(d) { // costs a 64-bit division
+        if (!d.isfinite() || !d.mantissa) return; // special divisors go through operator/
+        int lz = tinyfloat_clz(d.mantissa) - 8;
+        mantissa = d.mantissa << lz;
+        exponent = d.exponent - lz;
+        reciprocal = ((1ull<<55) - 1) / mantissa;
+    }
+
+    constexpr uint32_t quotient(uint32_t& remainder) const { // remainder*2^24 / mantissa, the remainder is updated
+        uint32_t q = (uint64_t(remainder) * reciprocal) >> 31; // q or q-1
+        remainder = (remainder << 24) - q * mantissa;           // the true remainder is below 2^25, wrapping is harmless
+        uint32_t fix = remainder >= mantissa;
+        remainder -= fix * mantissa;
+        return q + fix;
+    }
+};
+
+constexpr TinyFloat operator/(const TinyFloat &a, const TinyFloatDivisor &d) {
+    if (!d.mantissa || !a.isfinite() || !a.mantissa)
+        return a / d.divisor;
+
+    bool negative = a.negative != d.divisor.negative;
+    uint32_t a_mantissa = a.mantissa;
+    int a_lz = std::countl_zero(a_mantissa) - 8;       // normalize subnormals
+    a_mantissa <<= a_lz;
+    int exponent = a.exponent - a_lz - d.exponent;
+    if (a_mantissa < d.mantissa) {                     // the quotient is in [1, 2)
+        a_mantissa *= 2;
+        exponent--;
+    }
+
+    uint32_t mantissa  = 1;                            // the leading bit of the quotient
+    uint32_t remainder = a_mantissa - d.mantissa;
+    mantissa = mantissa * (1u<<24) + d.quotient(remainder);
+    mantissa = mantissa * 2 + (remainder != 0);        // 24 bits + guard bit + sticky bit
+
+    if (exponent < -126) {                             // denormalize, LSB is sticky
+        int shift = -126 - exponent;
+        mantissa = shift >= 26 ? mantissa != 0 : (mantissa >> shift) | (mantissa % (1u<<shift) != 0);
+        exponent = -126;
+    }
+
+    uint32_t g = (mantissa / 2) % 2;                   // guard bit
+    uint32_t s =  mantissa % 2;                        // sticky bit
+    mantissa /= 4;
+
+    mantissa += g & (s | mantissa);                    // round-to-nearest, even-on-ties, without a branch
+    if (mantissa == (1u<<24)) {                        // renormalize if necessary
+        mantissa /= 2;
+        exponent++;
+    }
+
+    if (exponent >= 128)                               // handle overflow
+        return TinyFloat::inf(negative);
+
+    return { negative, int16_t(exponent), mantissa };
+}
+
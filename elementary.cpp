@@ -0,0 +1,420 @@
+#include <algorithm>
+#include "elementary.h"
+
+// Fixed point 2.62: an int64_t v stands for v / 2^62, so the values in (-2, 2) carry 62 bits after the point.
+
+static constexpr int64_t one     = int64_t(1) << 62;
+static constexpr int64_t ln2     = 3196577161300663915;  // log(2)
+static constexpr int64_t log2e   = 6653256548922161246;  // 1/log(2)
+static constexpr int64_t half_pi = 7244019458077122842;  // pi/2
+static constexpr uint64_t pi     = 14488038916154245685u; // 3.14 does not fit in 2.62 signed, unsigned it does
+
+static constexpr int64_t exp2_table[64] = {                // 2^(j/64)
+    4611686018427387904, 4661903986662671290, 4712668792719003884, 4763986391269842979,
+    4815862801830788490, 4868304109465667592, 4921316465500308116, 4974906088244084429,
+    5029079263719320435, 5083842346398635251, 5139201759950318048, 5195163997991819502,
+    5251735624851448219, 5308923276338361494, 5366733660520940721, 5425173558513642752,
+    5484249825272419512, 5543969390398799154, 5604339258952723100, 5665366512274234280,
+    5727058308814112983, 5789421884973557729, 5852464555953009676, 5916193716610220111,
+    5980616842327661685, 6045741489889385141, 6111575298367424380, 6178125990017853852,
+    6245401371186603363, 6313409333225136570, 6382157853416100552, 6451654995909055045,
+    6521908912666391106, 6592927844419550153, 6664720121635655541, 6737294165494670078,
+    6810658488877194079, 6884821697363019841, 6959792490240559659, 7035579661527265796,
+    7112192101001162095, 7189638795243608238, 7267928828693418961, 7347071384712461870,
+    7427075746662858866, 7507951298995917514, 7589707528352920109, 7672354024677899536,
+    7755900482342532474, 7840356701283281883, 7925732588150922155, 8012038157472581778,
+    8099283532826439817, 8187478948029213993, 8276634748336579668, 8366761391656660532,
+    8457869449776733335, 8549969609603290562, 8643072674415606502, 8737189565132953757,
+    8832331321595618838, 8928509103859867100, 9025734193507008925, 9124017994966720698,
+};
+
+static constexpr int64_t exp2_poly[4] = {                  // 2^t - 1 = t log(2) + (t log(2))^2/2 + ..., Taylor
+    3196577161300663915, 1107849223398934356, 255967521894832113, 44355791529079737
+};
+
+static constexpr uint32_t log_reciprocal[128] = {          // c_j ~ 1/(1 + (j+1/2)/128) in 8.24, 1 and 1/2 at the ends
+    16777216, 16582885, 16455813, 16330674, 16207424, 16086020, 15966421, 15848588,
+    15732481, 15618063, 15505297, 15394148, 15284581, 15176563, 15070061, 14965043,
+    14861479, 14759338, 14658591, 14559211, 14461169, 14364439, 14268994, 14174810,
+    14081860, 13990121, 13899571, 13810184, 13721940, 13634817, 13548793, 13463847,
+    13379960, 13297112, 13215284, 13134457, 13054612, 12975732, 12897800, 12820798,
+    12744710, 12669520, 12595212, 12521771, 12449181, 12377427, 12306497, 12236374,
+    12167046, 12098499, 12030721, 11963697, 11897416, 11831866, 11767034, 11702908,
+    11639478, 11576731, 11514658, 11453246, 11392486, 11332368, 11272880, 11214014,
+    11155759, 11098107, 11041047, 10984571, 10928670, 10873335, 10818557, 10764329,
+    10710642, 10657487, 10604858, 10552745, 10501143, 10450042, 10399437, 10349319,
+    10299682, 10250519, 10201823, 10153587, 10105805, 10058471, 10011579, 9965121,
+    9919093, 9873488, 9828300, 9783525, 9739155, 9695186, 9651612, 9608428,
+    9565629, 9523209, 9481164, 9439489, 9398178, 9357227, 9316632, 9276387,
+    9236489, 9196932, 9157713, 9118827, 9080269, 9042036, 9004124, 8966529,
+    8929246, 8892272, 8855603, 8819235, 8783164, 8747388, 8711901, 8676702,
+    8641785, 8607149, 8572789, 8538702, 8504886, 8471336, 8438050, 8388608,
+};
+
+static constexpr int64_t log_table[128] = {                // -log2(c_j), exact zeros at the ends
+    0, 77514670793429359, 128693853767067314, 179482211439424340,
+    229885759398793283, 279910511379308483, 329562051053027069, 378845504886599018,
+    427766783554988452, 476330897004350395, 524543198699902405, 572408524547858298,
+    619932035689358128, 667118344798359649, 713972371046657756, 760498898383410031,
+    806702115126181549, 852586937999018028, 898157668559888527, 943417964710927321,
+    988372652433990401, 1033025443221598332, 1077380754948610050, 1121441852050515063,
+    1165213635974393195, 1208699364708767186, 1251902028787845044, 1294826746528295076,
+    1337475979209822104, 1379853343602140875, 1421962662557396303, 1463807472527389152,
+    1505390512439504384, 1546715195347219079, 1587784618540808007, 1628602056082800835,
+    1669170960239395400, 1709493937376279213, 1749573750011826432, 1789413837065520317,
+    1829016764493962529, 1868385245816404226, 1907522143308180136, 1946429937824113045,
+    1985111783299109298, 2023570448268434911, 2061807220178592002, 2099826209767753840,
+    2137628961261776655, 2175218225361918672, 2212595779083119067, 2249765176293897208,
+    2286727880552346106, 2323486015595780247, 2360042381676790127, 2396399334849964258,
+    2432558200669615979, 2468522117533404899, 2504292039258941268, 2539871321103504664,
+    2575261110413417735, 2610463220869559293, 2645480738858459686, 2680314495325774689,
+    2714967179233943924, 2749439787694546642, 2783735195665314428, 2817854568872615553,
+    2851799753077065287, 2885572678243393176, 2919175359092566270, 2952608659472576956,
+    2985874746629184305, 3018975874139130143, 3051912500274643573, 3084687655352318368,
+    3117301302000467997, 3149756624895239971, 3182053710958151902, 3214195258164288533,
+    3246182116165796424, 3278015836501007985, 3309698036331949140, 3341230398844816308,
+    3372614015281181317, 3403850031286977809, 3434939647285482671, 3465885454150255000,
+    3496687440027518625, 3527347645675256566, 3557867503479952040, 3588247142250653868,
+    3618489455432712857, 3648594673441440997, 3678564438057634010, 3708399756393204147,
+    3738101681234331148, 3767672009967023306, 3797111195148697249, 3826420428300396216,
+    3855601655668453641, 3884655460894415266, 3913582462546124349, 3942384748821290728,
+    3971062307161558814, 3999617318550638399, 4028049845107599617, 4056361431935085157,
+    4084553672896971610, 4112626739213360115, 4140581565433320640, 4168419123129094698,
+    4196141166213622472, 4223748002016336753, 4251240714416392966, 4278620425126977898,
+    4305888293887729132, 4333043997454683357, 4360090280987814017, 4387026119034965412,
+    4413854337192490655, 4440573959813918174, 4467187117536810662, 4493694434283395037,
+    4520095778728840589, 4546393390509087436, 4572587195953972164, 0,
+};
+
+static constexpr int64_t log_poly[6] = { one, -one/2, one/3, -one/4, one/5, -one/6 }; // log(1+r)/r
+
+static constexpr int64_t sin_poly[7] = { one, -one/6, one/120, -one/5040, one/362880, -one/39916800, one/6227020800 };
+static constexpr int64_t cos_poly[8] = { one, -one/2, one/24, -one/720, one/40320, -one/3628800, one/479001600, -one/87178291200 };
+
+static constexpr uint32_t two_over_pi[10] = {              // 2/pi = 0.a2f9836e4e441529... in hexadecimal
+    0xa2f9836e, 0x4e441529, 0xfc2757d1, 0xf534ddc0, 0xdb629599, 0x3c439041, 0xfe5163ab, 0xdebbc561, 0xb7246e3a, 0x424dd2e0
+};
+
+static constexpr int64_t atan_table[65] = {                // atan(j/64)
+    0, 72051730834756822, 144068303048368715, 216014660847748415,
+    287855953345232185, 359557635144771419, 431085564716663715, 502406099870281951,
+    573486189672913778, 644293462209565554, 714796307632436780, 784963956008629488,
+    854766549539324179, 924175208791872270, 993162092656742658, 1061700451812743993,
+    1129764675555192497, 1197330331911545433, 1264374201036404774, 1330874301941761470,
+    1396809912678075341, 1462161584136587689, 1526911147692607963, 1591041716953014678,
+    1654537683908620430, 1717384709823264602, 1779569711216534894, 1841080841316014184,
+    1901907467368135863, 1962040144204426348, 2021470584462503821, 2080191625859125399,
+    2138197195906305897, 2195482274451567684, 2252042854410229708, 2307875901041809190,
+    2362979310104584075, 2417351865202619417, 2470993194618540525, 2523903727903450851,
+    2576084652473018343, 2627537870436226105, 2678265955860898238, 2728272112658126051,
+    2777560133246350984, 2826134358135288686, 2873999636550248571, 2921161288198826882,
+    2967625066264511049, 3013397121695484069, 3058483968841891186, 3102892452481037736,
+    3146629716257419296, 3189703172553120731, 3232120473793924516, 3273889485187395884,
+    3315018258881210269, 3355515009522998796, 3395388091196947616, 3434645975707231915,
+    3473297232174029200, 3511350507904272941, 3548814510496411477, 3585697991136164741,
+    3622009729038561421,
+};
+
+static constexpr int64_t atan_poly[5] = { one, -one/3, one/5, -one/7, one/9 }; // atan(u)/u
+
+static TinyFloat round(int exponent, int64_t value) {     // value * 2^exponent
+    return round_to_tinyfloat(value < 0, exponent, value < 0 ? 0 - uint64_t(value) : uint64_t(value));
+}
+
+static uint64_t multiply(uint64_t a, uint64_t b) {         // a * b / 2^62 truncated, with 32x32->64 bit multiplications
+    uint64_t a_hi = a >> 32, a_lo = uint32_t(a);
+    uint64_t b_hi = b >> 32, b_lo = uint32_t(b);
+    uint64_t lolo = a_lo * b_lo, hilo = a_hi * b_lo, lohi = a_lo * b_hi, hihi = a_hi * b_hi;
+    uint64_t mid = (lolo >> 32) + uint32_t(hilo) + uint32_t(lohi);
+    uint64_t hi = hihi + (hilo >> 32) + (lohi >> 32) + (mid >> 32);
+    return (hi << 2) | (uint32_t(mid) >> 30);
+}
+
+static int64_t multiply(int64_t a, int64_t b) {            // the same, signed, rounded toward zero
+    uint64_t p = multiply(a < 0 ? 0 - uint64_t(a) : uint64_t(a), b < 0 ? 0 - uint64_t(b) : uint64_t(b));
+    return (a < 0) != (b < 0) ? -int64_t(p) : int64_t(p);
+}
+
+// a * 2^62 / b truncated, a < 2b, b <= 2^63: radix-2^32 long division of the 128-bit a * 2^62 (Knuth's algorithm D),
+// each digit is estimated from the top 32 bits of the normalized divisor and corrected at most twice
+static uint64_t divide(uint64_t a, uint64_t b) {
+    int s = std::countl_zero(b);                           // normalize b, the quotient does not change
+    b <<= s;
+    uint64_t b_hi = b >> 32, b_lo = uint32_t(b);
+    uint64_t u1 = (a >> 2 << s) | (s ? (a << 62) >> (64 - s) : 0); // a * 2^(62+s) = u1 * 2^64 + u0 with u1 < b
+    uint64_t u0 = a << 62 << s;
+    uint64_t q = 0, r = u1;
+    for (int i=0; i<2; i++) {                              // r < b, the next digit fits in 32 bits
+        uint64_t next = i == 0 ? u0 >> 32 : uint32_t(u0);
+        uint64_t digit = r / b_hi, rest = r % b_hi;        // an estimate, at most 2 too large
+        while (digit >> 32 || digit * b_lo > (rest << 32 | next)) {
+            digit--;
+            rest += b_hi;
+            if (rest >> 32)                                // digit * b_lo can no longer exceed it
+                break;
+        }
+        r = (r << 32 | next) - digit * b;                  // the borrow cancels the bits shifted out of r
+        q = q << 32 | digit;
+    }
+    return q;
+}
+
+static int64_t polynomial(const int64_t* c, int degree, int64_t x) { // Horner
+    int64_t p = c[degree];
+    for (int i=degree-1; i>=0; i--)
+        p = c[i] + multiply(p, x);
+    return p;
+}
+
+static uint64_t shift(uint64_t v, int bits) {              // v * 2^bits truncated, it must fit
+    return bits >= 0 ? v << bits : bits > -64 ? v >> -bits : 0;
+}
+
+static int64_t to_fixed(const TinyFloat& x, int bits) {  // x * 2^bits truncated toward zero, it must fit
+    int64_t v = int64_t(shift(x.mantissa, x.exponent - 23 + bits));
+    return x.negative ? -v : v;
+}
+
+// 2^x = 2^n * 2^(j/64) * 2^t with an integer n, j in [0, 64) and t in [0, 1/64)
+static TinyFloat exp2_fixed(int64_t x) {                   // 2^(x / 2^40), |x| < 2^49
+    int n = int(x >> 40);                                  // floor
+    uint64_t f = uint64_t(x) % (uint64_t(1) << 40);
+    int j = int(f >> 34);
+    int64_t t = int64_t(f % (uint64_t(1) << 34)) << 22;
+    int64_t p = multiply(polynomial(exp2_poly, 3, t), t);
+    return round(n - 62, exp2_table[j] + multiply(exp2_table[j], p));
+}
+
+TinyFloat exp2(const TinyFloat& x) {
+    if (x.isnan()) return TinyFloat::nan();
+    if (x.isinf() || x.exponent >= 8)                      // |x| >= 256
+        return x.negative ? TinyFloat::zero() : TinyFloat::inf();
+    if (x.exponent < -25)                                  // 1 + x log(2) rounds to 1
+        return 1;
+    return exp2_fixed(to_fixed(x, 40));
+}
+
+TinyFloat exp(const TinyFloat& x) {
+    if (x.isnan()) return TinyFloat::nan();
+    if (x.isinf() || x.exponent >= 8)
+        return x.negative ? TinyFloat::zero() : TinyFloat::inf();
+    if (x.exponent < -25)                                  // 1 + x rounds to 1
+        return 1;
+    return exp2_fixed(multiply(to_fixed(x, 40), log2e));
+}
+
+// x = 2^k * m, m in [1, 2), then log(x) = k log(2) + log(1/c) + log(1 + r) with r = m*c - 1, |r| < 2^-7. The product m*c
+// is exact, and c = 1 near 1 and 1/2 near 2 leave log(1 + r) alone close to x = 1, so the relative error stays small there.
+struct LogParts {
+    int k;
+    int64_t table;                                         // log2(1/c)
+    int64_t series;                                        // log(1 + r)
+};
+
+static LogParts log_parts(const TinyFloat& x) {            // x finite and positive
+    int k = x.exponent;
+    uint32_t m = x.mantissa;
+    int lz = std::countl_zero(m) - 8;                      // normalize subnormals
+    m <<= lz;
+    k -= lz;
+
+    int j = (m >> 16) % 128;
+    int64_t r = (int64_t(m) * log_reciprocal[j] - (int64_t(1) << 47)) << 15; // m*c in units of 2^-47 is exact
+    return { j == 127 ? k + 1 : k, log_table[j], multiply(polynomial(log_poly, 5, r), r) };
+}
+
+TinyFloat log2(const TinyFloat& x) {
+    if (x.isnan() || (x.negative && (x.mantissa || x.isinf()))) return TinyFloat::nan();
+    if (x.isinf()) return x;
+    if (!x.mantissa) return TinyFloat::inf(true);         // log(+-0) = -inf
+    auto [k, table, series] = log_parts(x);
+    int64_t fraction = table + multiply(series, log2e);
+    if (!k && !table)                                      // close to 1, no integer part
+        return round(-62, fraction);
+    return round(-55, int64_t(k) * (int64_t(1) << 55) + (fraction >> 7));
+}
+
+TinyFloat log(const TinyFloat& x) {
+    if (x.isnan() || (x.negative && (x.mantissa || x.isinf()))) return TinyFloat::nan();
+    if (x.isinf()) return x;
+    if (!x.mantissa) return TinyFloat::inf(true);
+    auto [k, table, series] = log_parts(x);
+    if (!k && !table)
+        return round(-62, series);
+    int64_t whole = int64_t(k) * (int64_t(1) << 55) + (table >> 7); // log2, 9.55
+    return round(-55, multiply(whole, ln2) + (series >> 7));
+}
+
+static int integer_kind(const TinyFloat& y) {              // 0: not an integer, 1: odd, 2: even; y finite
+    if (!y.mantissa || y.exponent >= 24) return 2;
+    if (y.exponent < 0) return 0;
+    uint32_t fraction = y.mantissa % (1u << (23 - y.exponent));
+    if (fraction) return 0;
+    return (y.mantissa >> (23 - y.exponent)) % 2 ? 1 : 2;
+}
+
+TinyFloat pow(const TinyFloat& x, const TinyFloat& y) {
+    if (y.isfinite() && !y.mantissa) return 1;             // x^0 = 1, even for nan
+    if (x == TinyFloat(1)) return 1;                       // 1^y = 1, even for nan
+    if (x.isnan() || y.isnan()) return TinyFloat::nan();
+
+    bool x_negative = x.negative;
+    TinyFloat a = { false, x.exponent, x.mantissa };       // |x|
+    if (y.isinf()) {
+        if (a == TinyFloat(1)) return 1;                   // (-1)^inf = 1
+        return (a < TinyFloat(1)) != y.negative ? TinyFloat::zero() : TinyFloat::inf();
+    }
+    int kind = integer_kind(y);
+    bool negative = x_negative && kind == 1;               // odd powers keep the sign
+    if (!x.mantissa)                                       // 0^y and inf^y
+        return x.isinf() != y.negative ? TinyFloat::inf(negative) : TinyFloat::zero(negative);
+    if (x_negative && !kind)                               // a negative number to a non-integer power
+        return TinyFloat::nan();
+    if (a == TinyFloat(1))                                 // (-1)^y = +-1 for an integer y
+        return negative ? -1 : 1;
+
+    auto [k, table, series] = log_parts(a);                // y * log2|x| = y * l * 2^exponent
+    int64_t l = table + multiply(series, log2e);
+    int exponent = -62;
+    if (k || table) {
+        l = int64_t(k) * (int64_t(1) << 55) + (l >> 7);
+        exponent = -55;
+    }
+    uint64_t magnitude = l < 0 ? 0 - uint64_t(l) : uint64_t(l);
+    int dropped = std::max(64 - std::countl_zero(magnitude) - 40, 0); // keep 40 bits so that the product fits
+    uint64_t product = (magnitude >> dropped) * y.mantissa;
+    exponent += dropped + y.exponent - 23;
+    bool product_negative = (l < 0) != y.negative;
+    if (64 - std::countl_zero(product) + exponent > 8)    // |y log2 x| >= 256
+        return product_negative ? TinyFloat::zero(negative) : TinyFloat::inf(negative);
+    int64_t fixed = int64_t(shift(product, exponent + 40));
+    TinyFloat result = exp2_fixed(product_negative ? -fixed : fixed);
+    result.negative = negative;
+    return result;
+}
+
+static uint32_t two_over_pi_bits(int t) {                  // 32 bits of 2/pi from the 2^-t place on
+    if (t < 1)
+        return t > -31 ? two_over_pi[0] >> (1 - t) : 0;
+    int i = (t - 1) / 32, o = (t - 1) % 32;
+    return o ? (two_over_pi[i] << o) | (two_over_pi[i+1] >> (32 - o)) : two_over_pi[i];
+}
+
+// Payne-Hanek: x * 2/pi = k + f, only the bits of 2/pi that reach the last two bits of k and 62 bits of f are used,
+// so the reduction is exact enough for every float, then x = (k + f) pi/2 with |f| <= 1/2.
+static int64_t reduce(const TinyFloat& x, int& k) {        // x >= 1/2, returns f pi/2 in 2.62
+    int s = x.exponent - 23;                               // x = m * 2^s
+    uint64_t m = x.mantissa;
+    uint64_t p0 = m * two_over_pi_bits(s + 63);            // m * (the 96-bit window of 2/pi * 2^(s+94))
+    uint64_t p1 = m * two_over_pi_bits(s + 31) + (p0 >> 32);
+    uint64_t p2 = m * two_over_pi_bits(s - 1)  + (p1 >> 32); // modulo 4
+    k = uint32_t(p2) >> 30;
+    int64_t f = int64_t((uint64_t(uint32_t(p2) % (1u<<30)) << 32) | uint32_t(p1));
+    if (f >= one / 2) {                                    // round to the nearest quadrant
+        f -= one;
+        k++;
+    }
+    return multiply(f, half_pi);
+}
+
+static int64_t sine(int64_t r)   { return multiply(r, polynomial(sin_poly, 6, multiply(r, r))); } // |r| <= pi/4
+static int64_t cosine(int64_t r) { return polynomial(cos_poly, 7, multiply(r, r)); }
+
+static int64_t reduce_small(const TinyFloat& x, int& k) { // |x| >= 2^-12
+    k = 0;
+    if (x.exponent < -1)                                   // |x| < 1/2, no reduction
+        return to_fixed({ false, x.exponent, x.mantissa }, 62);
+    return reduce(x, k);
+}
+
+TinyFloat sin(const TinyFloat& x) {
+    if (!x.isfinite()) return TinyFloat::nan();
+    if (x.exponent < -12)                                  // x - x^3/6 rounds to x
+        return x;
+    int k;
+    int64_t r = reduce_small(x, k);
+    int64_t v = k % 2 ? cosine(r) : sine(r);
+    TinyFloat result = round(-62, k % 4 >= 2 ? -v : v);
+    result.negative ^= x.negative;
+    return result;
+}
+
+TinyFloat cos(const TinyFloat& x) {
+    if (!x.isfinite()) return TinyFloat::nan();
+    if (x.exponent < -12)                                  // 1 - x^2/2 rounds to 1
+        return 1;
+    int k;
+    int64_t r = reduce_small(x, k);
+    int64_t v = k % 2 ? sine(r) : cosine(r);
+    return round(-62, (k + 1) % 4 >= 2 ? -v : v);
+}
+
+TinyFloat tan(const TinyFloat& x) {
+    if (!x.isfinite()) return TinyFloat::nan();
+    if (x.exponent < -12)                                  // x + x^3/3 rounds to x
+        return x;
+    int k;
+    int64_t r = reduce_small(x, k);
+    int64_t s = sine(r), c = cosine(r);
+    bool negative = (s < 0) != (k % 2 == 1);               // -cos/sin in the odd quadrants
+    uint64_t a = s < 0 ? 0 - uint64_t(s) : uint64_t(s);
+    TinyFloat result;
+    if (k % 2 == 0)
+        result = round_to_tinyfloat(negative, -62, divide(a, c)); // |sin| <= cos
+    else {                                                 // cos/sin may be large, normalize sin first
+        int lz = std::countl_zero(a) - 1;
+        result = round_to_tinyfloat(negative, lz - 62, divide(c, a << lz));
+    }
+    result.negative ^= x.negative;
+    return result;
+}
+
+// atan(t) = atan(j/64) + atan(u) with u = (t - j/64) / (1 + t j/64), |u| <= 1/128, for t = min(|x|,|y|)/max(|x|,|y|)
+TinyFloat atan2(const TinyFloat& y, const TinyFloat& x) {
+    if (x.isnan() || y.isnan()) return TinyFloat::nan();
+    bool negative = y.negative;
+    uint64_t angle = 0;                                    // the result in 2.62 for the special cases
+    if (y.isinf())
+        angle = x.isinf() ? (x.negative ? pi - half_pi / 2 : half_pi / 2) : half_pi;
+    else if (x.isinf() || !y.mantissa)
+        angle = x.negative ? pi : 0;
+    else if (!x.mantissa)
+        angle = half_pi;
+    else {
+        int ex = x.exponent, ey = y.exponent;
+        uint64_t mx = x.mantissa, my = y.mantissa;
+        int lx = std::countl_zero(uint32_t(mx)) - 8, ly = std::countl_zero(uint32_t(my)) - 8; // normalize subnormals
+        mx <<= lx; ex -= lx;
+        my <<= ly; ey -= ly;
+        bool swapped = ey > ex || (ey == ex && my > mx);   // |y| > |x|: atan2 = pi/2 - atan(|x|/|y|)
+        if (swapped) {
+            std::swap(mx, my);
+            std::swap(ex, ey);
+        }
+        uint64_t q = (my << 39) / mx;                      // t = q * 2^te, q in (2^38, 2^40]
+        int te = ey - ex - 39;
+
+        if (63 - std::countl_zero(q) + te < -7) {          // t < 2^-7: atan(t) = t (1 - t^2/3 + ...), no table
+            int64_t t = int64_t(shift(q, te + 62));
+            uint64_t m = multiply(q, uint64_t(polynomial(atan_poly, 4, multiply(t, t))));
+            if (!swapped && !x.negative)                   // tiny results keep their relative precision
+                return round_to_tinyfloat(negative, te, m);
+            angle = shift(m, te + 62);
+        } else {
+            int64_t t = int64_t(q << (te + 62));
+            int j = int((t + (one >> 7)) >> 56);           // nearest j/64
+            int64_t c = int64_t(j) << 56;
+            int64_t num = t - c;
+            uint64_t den = uint64_t(one) + uint64_t(multiply(t, c));
+            uint64_t u = divide(num < 0 ? 0 - uint64_t(num) : uint64_t(num), den);
+            int64_t v = num < 0 ? -int64_t(u) : int64_t(u);
+            angle = uint64_t(atan_table[j] + multiply(v, polynomial(atan_poly, 4, multiply(v, v))));
+        }
+        if (swapped)
+            angle = half_pi - angle;
+        if (x.negative)
+            angle = pi - angle;
+    }
+    return round_to_tinyfloat(negative, -62, angle);
+}
+
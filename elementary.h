@@ -0,0 +1,16 @@
+#pragma once
+#include "tinyfloat.h"
+
+// Elementary functions with integer arithmetic only: the argument is reduced with a table, a polynomial is evaluated
+// in 2.62 fixed point and the result is rounded once. All of them are faithful (the error is below 1 ulp), most of the
+// results are correctly rounded; the bounds below are the largest errors measured against the host libm in double.
+TinyFloat exp (const TinyFloat& x);                      // e^x,     max error 0.501 ulp
+TinyFloat exp2(const TinyFloat& x);                      // 2^x,     max error 0.501 ulp
+TinyFloat log (const TinyFloat& x);                      // ln(x),   max error 0.501 ulp
+TinyFloat log2(const TinyFloat& x);                      // log2(x), max error 0.501 ulp
+TinyFloat pow (const TinyFloat& x, const TinyFloat& y);  // x^y,     max error 0.502 ulp, special cases as in C99 Annex F
+TinyFloat sin (const TinyFloat& x);                      // max error 0.501 ulp, for any finite x (Payne-Hanek reduction)
+TinyFloat cos (const TinyFloat& x);                      // max error 0.501 ulp
+TinyFloat tan (const TinyFloat& x);                      // max error 0.501 ulp
+TinyFloat atan2(const TinyFloat& y, const TinyFloat& x); // max error 0.501 ulp, special cases as in C99 Annex F
+
@@ -0,0 +1,208 @@
+#include <algorithm>
+#include "format.h"
+#include "printer.h"
+#include "shortest.h"
+
+struct Output {                                // bounded writer, it remembers running out of space
+    char* p;
+    char* last;
+    bool overflow = false;
+
+    void put(char c) {
+        if (p == last) overflow = true;
+        else *p++ = c;
+    }
+    void put(const char* s) {
+        for (; *s; s++) put(*s);
+    }
+    void zeros(int n) {
+        for (; n > 0; n--) put('0');
+    }
+    void exponent(char marker, int e, int min_digits) { // e+05, p-126
+        put(marker);
+        put(e < 0 ? '-' : '+');
+        char digits[8];
+        int n = 0;
+        for (int a = e < 0 ? -e : e; a > 0 || n < min_digits; a /= 10)
+            digits[n++] = char('0' + a % 10);
+        while (n > 0) put(digits[--n]);
+    }
+};
+
+struct Decimal {                               // digits * 10^q, most significant digit first
+    char* digits;
+    int size;
+    int q;
+
+    int top() const { return q + size - 1; }   // power of 10 of the first digit
+    char digit(int power) const { return power >= q && power <= top() ? digits[top() - power] : '0'; }
+    int lowest() const {                       // power of 10 of the last nonzero digit
+        int n = size;
+        while (n > 0 && digits[n-1] == '0') n--;
+        return q + size - n;
+    }
+
+    void round(int r) {                        // to a multiple of 10^r, round-to-nearest, even-on-ties
+        int keep = size - (r - q);             // digits that stay
+        if (keep >= size) return;
+        if (keep < 0) {                        // below 10^(r-1)
+            size = 0;
+            q = r;
+            return;
+        }
+        bool rest = false;
+        for (int i=keep+1; i<size; i++)
+            rest |= digits[i] != '0';
+        bool odd = keep > 0 && (digits[keep-1] - '0') % 2;
+        bool up = digits[keep] > '5' || (digits[keep] == '5' && (rest || odd));
+        size = keep;
+        q = r;
+        if (up) {
+            int i = keep - 1;
+            for (; i >= 0 && digits[i] == '9'; i--)
+                digits[i] = '0';
+            if (i >= 0)
+                digits[i]++;
+            else {                             // 99.9 -> 100, there is room in front of the digits
+                *--digits = '1';
+                size++;
+            }
+        }
+    }
+};
+
+static void fixed(Output& out, const Decimal& d, int precision) { // d is already rounded to 10^-precision
+    if (!d.size || d.top() < 0)
+        out.put('0');
+    for (int power = d.top(); power >= 0; power--)
+        out.put(d.digit(power));
+    if (precision > 0)
+        out.put('.');
+    for (int power = -1; power >= -precision; power--)
+        out.put(d.digit(power));
+}
+
+static void scientific(Output& out, const Decimal& d, int precision) { // d is already rounded to its first precision+1 digits
+    int top = d.size ? d.top() : 0;
+    out.put(d.digit(top));
+    if (precision > 0)
+        out.put('.');
+    for (int power = top - 1; power >= top - precision; power--)
+        out.put(d.digit(power));
+    out.exponent('e', top, 2);
+}
+
+static void general(Output& out, Decimal& d, int precision) {   // %g: fixed or scientific, without trailing zeros
+    precision = std::max(precision, 1);
+    if (d.size)
+        d.round(d.top() - (precision - 1));
+    int x = d.size ? d.top() : 0;
+    int lowest = d.size ? d.lowest() : 0;
+    if (x >= -4 && x < precision)
+        fixed(out, d, std::max(-lowest, 0));
+    else
+        scientific(out, d, std::max(x - lowest, 0));
+}
+
+static void hex(Output& out, const TinyFloat& f, int precision) { // precision < 0 is shortest
+    uint32_t leading = f.mantissa >> 23;       // 1 for normals, 0 for subnormals
+    uint32_t fraction = (f.mantissa % (1u<<23)) << 1; // 6 hex digits
+    int exponent = f.mantissa ? int(f.exponent) : 0;
+    int digits = 6;
+    if (precision < 0)
+        for (; digits > 0 && fraction % 16 == 0; digits--)
+            fraction /= 16;
+    else if (precision < 6) {
+        int shift = 4 * (6 - precision);
+        uint32_t remainder = fraction % (1u<<shift), half = 1u<<(shift-1);
+        fraction >>= shift;
+        if (remainder > half || (remainder == half && (precision ? fraction : leading) % 2)) // the last digit kept is even
+            fraction++;
+        if (fraction >> (4 * precision)) {    // 1.ff -> 2.00
+            fraction = 0;
+            leading++;
+        }
+        digits = precision;
+    }
+    out.put(char('0' + leading));
+    if (digits > 0)
+        out.put('.');
+    for (int i=digits-1; i>=0; i--)
+        out.put("0123456789abcdef"[(fraction >> (4 * i)) % 16]);
+    out.zeros(precision - 6);
+    out.exponent('p', exponent, 1);
+}
+
+// the shortest decimal, fixed, scientific or general (like %g with precision 6 for the choice)
+static void shortest(Output& out, const TinyFloat& f, std::chars_format fmt, bool plain) {
+    ShortestDecimal s = shortest_decimal(f);
+    char text[16];
+    char* end = std::end(text);
+    char* begin = end;
+    for (uint32_t n = s.significand; n > 0 || begin == end; n /= 10)
+        *--begin = char('0' + n % 10);
+    Decimal d = { begin, int(end - begin), s.exponent };
+
+    int x = d.top();
+    if (plain) {                               // the shorter one, fixed on ties
+        int fixed_size = s.exponent >= 0 ? x + 1 : x >= 0 ? d.size + 1 : d.size + 1 - x;
+        int scientific_size = d.size + (d.size > 1) + 4;
+        fmt = fixed_size <= scientific_size ? std::chars_format::fixed : std::chars_format::scientific;
+    } else if (fmt != std::chars_format::fixed && fmt != std::chars_format::scientific)
+        fmt = x >= -4 && x < 6 ? std::chars_format::fixed : std::chars_format::scientific;
+
+    if (fmt == std::chars_format::scientific)
+        scientific(out, d, d.size - 1);
+    else if (s.exponent < 0)
+        fixed(out, d, -s.exponent);
+    else {                                     // an integer, all its digits are shown: the exact ones are the nearest
+        ExactDecimal e(f.mantissa, f.exponent - 23);
+        fixed(out, { e.digits, e.size, 0 }, 0);
+    }
+}
+
+static std::to_chars_result format(char* first, char* last, const TinyFloat& f, std::chars_format fmt, int precision, bool plain) {
+    Output out = { first, last };
+    if (f.negative)
+        out.put('-');
+    if (f.isnan())
+        out.put("nan");
+    else if (f.isinf())
+        out.put("inf");
+    else if (fmt == std::chars_format::hex)
+        hex(out, f, precision);
+    else if (precision < 0)
+        shortest(out, f, fmt, plain);
+    else {                                     // only the digits needed, one more to round and a sticky one
+        DecimalDigits e(f.mantissa, f.exponent - 23);
+        int r = fmt == std::chars_format::fixed      ? -precision
+              : fmt == std::chars_format::scientific ? e.top - precision : e.top - (std::max(precision, 1) - 1);
+        e.generate(r - 1);
+        Decimal d = { e.digits, e.size, e.q };
+        if (fmt == std::chars_format::fixed) {
+            d.round(r);
+            fixed(out, d, precision);
+        } else if (fmt == std::chars_format::scientific) {
+            if (d.size)
+                d.round(r);
+            scientific(out, d, precision);
+        } else
+            general(out, d, precision);
+    }
+    if (out.overflow)
+        return { last, std::errc::value_too_large };
+    return { out.p, std::errc() };
+}
+
+std::to_chars_result to_chars(char* first, char* last, const TinyFloat& f) {
+    return format(first, last, f, std::chars_format::general, -1, true);
+}
+
+std::to_chars_result to_chars(char* first, char* last, const TinyFloat& f, std::chars_format fmt) {
+    return format(first, last, f, fmt, -1, false);
+}
+
+std::to_chars_result to_chars(char* first, char* last, const TinyFloat& f, std::chars_format fmt, int precision) {
+    return format(first, last, f, fmt, precision < 0 ? 6 : precision, false); // like printf
+}
+
@@ -0,0 +1,12 @@
+#pragma once
+#include <charconv>
+#include "tinyfloat.h"
+
+// Formats a TinyFloat into [first, last) like std::to_chars does for float: no allocation, no locale, no host FPU.
+// Without a precision the output is the shortest one that reads back to the same value; fixed, scientific and
+// general with a precision behave like printf's %.*f, %.*e and %.*g, hex like %a without the 0x prefix.
+// If the buffer is too small, ec is value_too_large and ptr is last.
+std::to_chars_result to_chars(char* first, char* last, const TinyFloat& f);
+std::to_chars_result to_chars(char* first, char* last, const TinyFloat& f, std::chars_format fmt);
+std::to_chars_result to_chars(char* first, char* last, const TinyFloat& f, std::chars_format fmt, int precision);
+
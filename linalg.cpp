@@ -0,0 +1,204 @@
+#include <algorithm>
+#include <cassert>
+#include <vector>
+#include "linalg.h"
+#include "accumulator.h"
+
+constexpr int mc = 64, kc = 128, nc = 256; // blocks of unpacked values: 64 KB of A, 256 KB of B
+constexpr int mr = 4,  nr = 4;             // the micro-kernel computes a 4x4 tile of C, 16 independent sums
+
+// sum + a*b with both roundings, bit-identical to the operators. When the operands and both results are normal
+// (nearly always in a matrix product) the mantissas go through one 64-bit multiply and one 64-bit add with
+// conditional moves, instead of the data-dependent branches of operator* and operator+ that mispredict on random data.
+static TinyFloat multiply_add(const TinyFloat& sum, const TinyFloat& a, const TinyFloat& b) {
+    uint64_t p = uint64_t(a.mantissa) * b.mantissa; // [2^46, 2^48) for normals
+    int top = int(p >> 47);
+    int shift = 23 + top;
+    uint64_t pm = p >> shift, rest = p % (1ull<<shift), half = 1ull<<(shift-1);
+    pm += rest > half || (rest == half && pm % 2);   // round-to-nearest, even-on-ties
+    int pe = a.exponent + b.exponent + top + int(pm >> 24);
+    pm >>= pm >> 24;                                 // renormalize if necessary
+    bool normal = (a.mantissa >> 23) & (b.mantissa >> 23) & (sum.mantissa >> 23) & (a.exponent < 128) & (b.exponent < 128)
+                & (sum.exponent < 128) & (pe >= -126) & (pe < 128);
+    if (!normal)
+        return sum + a * b;
+
+    bool pn = a.negative != b.negative;
+    bool swap = sum.exponent < pe || (sum.exponent == pe && sum.mantissa < pm); // the larger one first
+    int      big_e = swap ? pe : int(sum.exponent),       small_e = swap ? int(sum.exponent) : pe;
+    uint64_t big_m = swap ? pm : uint64_t(sum.mantissa), small_m = swap ? uint64_t(sum.mantissa) : pm;
+    bool negative  = swap ? pn : sum.negative;
+    int d = std::min(big_e - small_e, 63);
+    big_m <<= 34;                                    // 34 guard bits, LSB is sticky
+    small_m <<= 34;
+    small_m = (small_m >> d) | (small_m % (1ull<<d) != 0);
+    uint64_t r = pn == sum.negative ? big_m + small_m : big_m - small_m;
+    if (!r)                                          // exact cancellation gives +0
+        return TinyFloat::zero();
+
+    int lz = std::countl_zero(r);                    // normalize to bit 63, nothing is lost
+    r <<= lz;
+    uint64_t m = r >> 40, low = r % (1ull<<40);
+    m += low > (1ull<<39) || (low == (1ull<<39) && m % 2);
+    int e = big_e + 6 - lz + int(m >> 24);
+    m >>= m >> 24;
+    if (e < -126 || e >= 128)                        // subnormal or overflow
+        return sum + a * b;
+    return { negative, int16_t(e), uint32_t(m) };
+}
+
+template <Accumulation mode>
+static TinyFloat step(const TinyFloat& sum, const TinyFloat& a, const TinyFloat& b) {
+    if constexpr (mode == Accumulation::fused)
+        return fma(a, b, sum);
+    else
+        return multiply_add(sum, a, b);
+}
+
+template <Accumulation mode>
+static TinyFloat dot(const PackedFloat* a, const PackedFloat* b, size_t n) {
+    if constexpr (mode == Accumulation::exact) {
+        Accumulator acc;
+        for (size_t i=0; i<n; i++)
+            acc.add_product(a[i], b[i]);
+        return acc.result();
+    } else if constexpr (mode == Accumulation::fused) {
+        TinyFloat sum;
+        for (size_t i=0; i<n; i++)
+            sum = fma(a[i], b[i], sum);
+        return sum;
+    } else {
+        TinyFloat sum;
+        for (size_t i=0; i<n; i++)
+            sum = multiply_add(sum, a[i], b[i]);
+        return sum;
+    }
+}
+
+TinyFloat dot(std::span<const PackedFloat> a, std::span<const PackedFloat> b, Accumulation mode) {
+    assert(a.size() == b.size());
+    switch (mode) {
+        case Accumulation::fused: return dot<Accumulation::fused>(a.data(), b.data(), a.size());
+        case Accumulation::exact: return dot<Accumulation::exact>(a.data(), b.data(), a.size());
+        default:                  return dot<Accumulation::rounded>(a.data(), b.data(), a.size());
+    }
+}
+
+template <Accumulation mode>
+static void gemv(int m, int n, const PackedFloat* a, const PackedFloat* x, PackedFloat* y) {
+    std::vector<TinyFloat> xs(x, x + n);       // x is used by every row, unpack it once
+    int i = 0;
+    for (; i+mr<=m; i+=mr) {                   // mr rows at once, the sums are independent
+        const PackedFloat* row = a + size_t(i) * n;
+        if constexpr (mode == Accumulation::exact) {
+            Accumulator acc[mr];
+            for (int j=0; j<n; j++)
+                for (int r=0; r<mr; r++)
+                    acc[r].add_product(row[size_t(r) * n + j], xs[j]);
+            for (int r=0; r<mr; r++)
+                y[i+r] = acc[r].result();
+        } else {
+            TinyFloat sum[mr];
+            for (int j=0; j<n; j++)
+                for (int r=0; r<mr; r++)
+                    sum[r] = step<mode>(sum[r], row[size_t(r) * n + j], xs[j]);
+            for (int r=0; r<mr; r++)
+                y[i+r] = sum[r];
+        }
+    }
+    for (; i<m; i++)
+        y[i] = dot<mode>(a + size_t(i) * n, x, n);
+}
+
+void gemv(int m, int n, std::span<const PackedFloat> a, std::span<const PackedFloat> x, std::span<PackedFloat> y, Accumulation mode) {
+    assert(m >= 0 && n >= 0 && a.size() == size_t(m) * n && x.size() == size_t(n) && y.size() == size_t(m));
+    switch (mode) {
+        case Accumulation::fused: return gemv<Accumulation::fused>(m, n, a.data(), x.data(), y.data());
+        case Accumulation::exact: return gemv<Accumulation::exact>(m, n, a.data(), x.data(), y.data());
+        default:                  return gemv<Accumulation::rounded>(m, n, a.data(), x.data(), y.data());
+    }
+}
+
+// a holds mr rows and b holds nr columns, both zero-padded and interleaved by k: a[p*mr + i], b[p*nr + j].
+// The first block along k starts from +0, the next ones continue the sums left in C.
+template <Accumulation mode>
+static void tile(int k, const TinyFloat* a, const TinyFloat* b, PackedFloat* c, int ldc, int rows, int cols, bool first) {
+    if constexpr (mode == Accumulation::exact) {
+        Accumulator acc[mr][nr];
+        for (int p=0; p<k; p++)
+            for (int i=0; i<mr; i++)
+                for (int j=0; j<nr; j++)
+                    acc[i][j].add_product(a[p*mr + i], b[p*nr + j]);
+        for (int i=0; i<rows; i++)
+            for (int j=0; j<cols; j++)
+                c[size_t(i) * ldc + j] = acc[i][j].result();
+    } else {
+        TinyFloat sum[mr][nr];
+        if (!first)
+            for (int i=0; i<rows; i++)
+                for (int j=0; j<cols; j++)
+                    sum[i][j] = c[size_t(i) * ldc + j];
+        for (int p=0; p<k; p++)
+            for (int i=0; i<mr; i++)
+                for (int j=0; j<nr; j++)
+                    sum[i][j] = step<mode>(sum[i][j], a[p*mr + i], b[p*nr + j]);
+        for (int i=0; i<rows; i++)
+            for (int j=0; j<cols; j++)
+                c[size_t(i) * ldc + j] = sum[i][j];
+    }
+}
+
+template <Accumulation mode>
+static void gemm(int m, int n, int k, const PackedFloat* a, const PackedFloat* b, PackedFloat* c) {
+    if (size_t(m) * n * k <= 4096) {           // 3x3 and 4x4 transforms: packing would cost more than it saves
+        for (int i=0; i<m; i++)
+            for (int j=0; j<n; j++) {
+                if constexpr (mode == Accumulation::exact) {
+                    Accumulator acc;
+                    for (int p=0; p<k; p++)
+                        acc.add_product(a[size_t(i) * k + p], b[size_t(p) * n + j]);
+                    c[size_t(i) * n + j] = acc.result();
+                } else {
+                    TinyFloat sum;
+                    for (int p=0; p<k; p++)
+                        sum = step<mode>(sum, a[size_t(i) * k + p], b[size_t(p) * n + j]);
+                    c[size_t(i) * n + j] = sum;
+                }
+            }
+        return;
+    }
+
+    int kb = mode == Accumulation::exact ? k : kc; // the exact sums are not split along k
+    std::vector<TinyFloat> pa(size_t(mc) * kb), pb(size_t(nc) * kb);
+    for (int jc=0; jc<n; jc+=nc) {
+        int nb = std::min(nc, n - jc);
+        for (int pc=0; pc<k; pc+=kb) {
+            int kk = std::min(kb, k - pc);
+            for (int jr=0; jr<nb; jr+=nr)      // unpack a panel of B, nr columns at a time
+                for (int p=0; p<kk; p++)
+                    for (int j=0; j<nr; j++)
+                        pb[size_t(jr) * kk + p*nr + j] = jr + j < nb ? TinyFloat(b[size_t(pc + p) * n + jc + jr + j]) : TinyFloat();
+            for (int ic=0; ic<m; ic+=mc) {
+                int mb = std::min(mc, m - ic);
+                for (int ir=0; ir<mb; ir+=mr)  // unpack a block of A, mr rows at a time
+                    for (int p=0; p<kk; p++)
+                        for (int i=0; i<mr; i++)
+                            pa[size_t(ir) * kk + p*mr + i] = ir + i < mb ? TinyFloat(a[size_t(ic + ir + i) * k + pc + p]) : TinyFloat();
+                for (int jr=0; jr<nb; jr+=nr)
+                    for (int ir=0; ir<mb; ir+=mr)
+                        tile<mode>(kk, &pa[size_t(ir) * kk], &pb[size_t(jr) * kk], c + size_t(ic + ir) * n + jc + jr, n,
+                                   std::min(mr, mb - ir), std::min(nr, nb - jr), pc == 0);
+            }
+        }
+    }
+}
+
+void gemm(int m, int n, int k, std::span<const PackedFloat> a, std::span<const PackedFloat> b, std::span<PackedFloat> c, Accumulation mode) {
+    assert(m >= 0 && n >= 0 && k >= 0 && a.size() == size_t(m) * k && b.size() == size_t(k) * n && c.size() == size_t(m) * n);
+    switch (mode) {
+        case Accumulation::fused: return gemm<Accumulation::fused>(m, n, k, a.data(), b.data(), c.data());
+        case Accumulation::exact: return gemm<Accumulation::exact>(m, n, k, a.data(), b.data(), c.data());
+        default:                  return gemm<Accumulation::rounded>(m, n, k, a.data(), b.data(), c.data());
+    }
+}
+
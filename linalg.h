@@ -0,0 +1,25 @@
+#pragma once
+#include <span>
+#include "tinyfloat.h"
+#include "packed.h"
+
+// Dense linear algebra over PackedFloat storage, matrices are row-major.
+// The operands are unpacked once into cache-sized panels, and the micro-kernels work on unpacked TinyFloats only.
+// Every output element is accumulated in order (k = 0, 1, ...) starting from +0, the blocking only changes the
+// order in which the elements are computed, so the rounded results are bit-identical to the naive loops.
+enum class Accumulation {
+    rounded, // sum = sum + a*b, two roundings per step, like the naive scalar loop
+    fused,   // sum = fma(a, b, sum), one rounding per step
+    exact    // an Accumulator per element, one rounding in the end: the result does not depend on the order
+};
+
+TinyFloat dot(std::span<const PackedFloat> a, std::span<const PackedFloat> b, Accumulation mode = Accumulation::rounded);
+
+// y = A x, A is m x n
+void gemv(int m, int n, std::span<const PackedFloat> a, std::span<const PackedFloat> x, std::span<PackedFloat> y,
+          Accumulation mode = Accumulation::rounded);
+
+// C = A B, A is m x k, B is k x n, C is m x n
+void gemm(int m, int n, int k, std::span<const PackedFloat> a, std::span<const PackedFloat> b, std::span<PackedFloat> c,
+          Accumulation mode = Accumulation::rounded);
+
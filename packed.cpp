@@ -0,0 +1,27 @@
+#include <cassert>
+#include "packed.h"
+
+void pack(std::span<const TinyFloat> src, std::span<PackedFloat> dst) {
+    assert(src.size() == dst.size());
+    for (size_t i=0; i<src.size(); i++)
+        dst[i] = src[i];
+}
+
+void unpack(std::span<const PackedFloat> src, std::span<TinyFloat> dst) {
+    assert(src.size() == dst.size());
+    for (size_t i=0; i<src.size(); i++)
+        dst[i] = src[i];
+}
+
+PackedVector pack(std::span<const TinyFloat> src) {
+    PackedVector dst(src.size());
+    pack(src, dst);
+    return dst;
+}
+
+std::vector<TinyFloat> unpack(std::span<const PackedFloat> src) {
+    std::vector<TinyFloat> dst(src.size());
+    unpack(src, dst);
+    return dst;
+}
+
@@ -0,0 +1,26 @@
+#pragma once
+#include <span>
+#include <vector>
+#include "tinyfloat.h"
+
+// TinyFloat is convenient for computing, but it takes 8 bytes per value.
+// PackedFloat stores the very same value in 4 bytes using the IEEE 754 binary32 layout,
+// it converts implicitly to and from TinyFloat, so it can be used as an element type for large arrays.
+struct PackedFloat {
+    uint32_t bits = 0;
+
+    constexpr PackedFloat() = default;
+    constexpr PackedFloat(const TinyFloat& f) : bits(f.bits()) {}
+    constexpr operator TinyFloat() const { return TinyFloat::from_bits(bits); }
+};
+
+static_assert(sizeof(PackedFloat) == 4);
+
+using PackedVector = std::vector<PackedFloat>;
+
+void   pack(std::span<const TinyFloat>   src, std::span<PackedFloat> dst);
+void unpack(std::span<const PackedFloat> src, std::span<TinyFloat>   dst);
+
+PackedVector           pack(std::span<const TinyFloat>   src);
+std::vector<TinyFloat> unpack(std::span<const PackedFloat> src);
+
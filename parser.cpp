@@ -0,0 +1,374 @@
+#include <algorithm>
+#include <cstring>
+#include "parser.h"
+
+// Decimal numbers are converted with the Eisel-Lemire algorithm: the significant digits w (up to 19 of them)
+// are multiplied by a truncated 128-bit approximation of 5^q, which is enough to decide the rounding of w * 10^q
+// (D. Lemire, "Number Parsing at a Gigabyte per Second", 2021; N. Mushtak, D. Lemire, "Fast Number Parsing
+// Without Fallback", 2023). If there are more than 19 digits, w and w+1 bracket the value, and only when they
+// round differently the exact digits are compared to the halfway point with big integer arithmetic.
+
+struct Power5 { uint64_t hi, lo; };
+
+static constexpr int smallest_power = -64;     // w * 10^q < 2^-150 below, it rounds to zero
+static constexpr int largest_power  =  38;     // w * 10^q > 2^128 above, it rounds to infinity
+
+static constexpr Power5 powers_of_five[] = {   // 5^q normalized to 128 bits, truncated (rounded up for q < 0)
+    {0xa87fea27a539e9a5, 0x3f2398d747b36224}, // 5^-64
+    {0xd29fe4b18e88640e, 0x8eec7f0d19a03aad}, // 5^-63
+    {0x83a3eeeef9153e89, 0x1953cf68300424ac}, // 5^-62
+    {0xa48ceaaab75a8e2b, 0x5fa8c3423c052dd7}, // 5^-61
+    {0xcdb02555653131b6, 0x3792f412cb06794d}, // 5^-60
+    {0x808e17555f3ebf11, 0xe2bbd88bbee40bd0}, // 5^-59
+    {0xa0b19d2ab70e6ed6, 0x5b6aceaeae9d0ec4}, // 5^-58
+    {0xc8de047564d20a8b, 0xf245825a5a445275}, // 5^-57
+    {0xfb158592be068d2e, 0xeed6e2f0f0d56712}, // 5^-56
+    {0x9ced737bb6c4183d, 0x55464dd69685606b}, // 5^-55
+    {0xc428d05aa4751e4c, 0xaa97e14c3c26b886}, // 5^-54
+    {0xf53304714d9265df, 0xd53dd99f4b3066a8}, // 5^-53
+    {0x993fe2c6d07b7fab, 0xe546a8038efe4029}, // 5^-52
+    {0xbf8fdb78849a5f96, 0xde98520472bdd033}, // 5^-51
+    {0xef73d256a5c0f77c, 0x963e66858f6d4440}, // 5^-50
+    {0x95a8637627989aad, 0xdde7001379a44aa8}, // 5^-49
+    {0xbb127c53b17ec159, 0x5560c018580d5d52}, // 5^-48
+    {0xe9d71b689dde71af, 0xaab8f01e6e10b4a6}, // 5^-47
+    {0x9226712162ab070d, 0xcab3961304ca70e8}, // 5^-46
+    {0xb6b00d69bb55c8d1, 0x3d607b97c5fd0d22}, // 5^-45
+    {0xe45c10c42a2b3b05, 0x8cb89a7db77c506a}, // 5^-44
+    {0x8eb98a7a9a5b04e3, 0x77f3608e92adb242}, // 5^-43
+    {0xb267ed1940f1c61c, 0x55f038b237591ed3}, // 5^-42
+    {0xdf01e85f912e37a3, 0x6b6c46dec52f6688}, // 5^-41
+    {0x8b61313bbabce2c6, 0x2323ac4b3b3da015}, // 5^-40
+    {0xae397d8aa96c1b77, 0xabec975e0a0d081a}, // 5^-39
+    {0xd9c7dced53c72255, 0x96e7bd358c904a21}, // 5^-38
+    {0x881cea14545c7575, 0x7e50d64177da2e54}, // 5^-37
+    {0xaa242499697392d2, 0xdde50bd1d5d0b9e9}, // 5^-36
+    {0xd4ad2dbfc3d07787, 0x955e4ec64b44e864}, // 5^-35
+    {0x84ec3c97da624ab4, 0xbd5af13bef0b113e}, // 5^-34
+    {0xa6274bbdd0fadd61, 0xecb1ad8aeacdd58e}, // 5^-33
+    {0xcfb11ead453994ba, 0x67de18eda5814af2}, // 5^-32
+    {0x81ceb32c4b43fcf4, 0x80eacf948770ced7}, // 5^-31
+    {0xa2425ff75e14fc31, 0xa1258379a94d028d}, // 5^-30
+    {0xcad2f7f5359a3b3e, 0x096ee45813a04330}, // 5^-29
+    {0xfd87b5f28300ca0d, 0x8bca9d6e188853fc}, // 5^-28
+    {0x9e74d1b791e07e48, 0x775ea264cf55347e}, // 5^-27
+    {0xc612062576589dda, 0x95364afe032a819e}, // 5^-26
+    {0xf79687aed3eec551, 0x3a83ddbd83f52205}, // 5^-25
+    {0x9abe14cd44753b52, 0xc4926a9672793543}, // 5^-24
+    {0xc16d9a0095928a27, 0x75b7053c0f178294}, // 5^-23
+    {0xf1c90080baf72cb1, 0x5324c68b12dd6339}, // 5^-22
+    {0x971da05074da7bee, 0xd3f6fc16ebca5e04}, // 5^-21
+    {0xbce5086492111aea, 0x88f4bb1ca6bcf585}, // 5^-20
+    {0xec1e4a7db69561a5, 0x2b31e9e3d06c32e6}, // 5^-19
+    {0x9392ee8e921d5d07, 0x3aff322e62439fd0}, // 5^-18
+    {0xb877aa3236a4b449, 0x09befeb9fad487c3}, // 5^-17
+    {0xe69594bec44de15b, 0x4c2ebe687989a9b4}, // 5^-16
+    {0x901d7cf73ab0acd9, 0x0f9d37014bf60a11}, // 5^-15
+    {0xb424dc35095cd80f, 0x538484c19ef38c95}, // 5^-14
+    {0xe12e13424bb40e13, 0x2865a5f206b06fba}, // 5^-13
+    {0x8cbccc096f5088cb, 0xf93f87b7442e45d4}, // 5^-12
+    {0xafebff0bcb24aafe, 0xf78f69a51539d749}, // 5^-11
+    {0xdbe6fecebdedd5be, 0xb573440e5a884d1c}, // 5^-10
+    {0x89705f4136b4a597, 0x31680a88f8953031}, // 5^-9
+    {0xabcc77118461cefc, 0xfdc20d2b36ba7c3e}, // 5^-8
+    {0xd6bf94d5e57a42bc, 0x3d32907604691b4d}, // 5^-7
+    {0x8637bd05af6c69b5, 0xa63f9a49c2c1b110}, // 5^-6
+    {0xa7c5ac471b478423, 0x0fcf80dc33721d54}, // 5^-5
+    {0xd1b71758e219652b, 0xd3c36113404ea4a9}, // 5^-4
+    {0x83126e978d4fdf3b, 0x645a1cac083126ea}, // 5^-3
+    {0xa3d70a3d70a3d70a, 0x3d70a3d70a3d70a4}, // 5^-2
+    {0xcccccccccccccccc, 0xcccccccccccccccd}, // 5^-1
+    {0x8000000000000000, 0x0000000000000000}, // 5^0
+    {0xa000000000000000, 0x0000000000000000}, // 5^1
+    {0xc800000000000000, 0x0000000000000000}, // 5^2
+    {0xfa00000000000000, 0x0000000000000000}, // 5^3
+    {0x9c40000000000000, 0x0000000000000000}, // 5^4
+    {0xc350000000000000, 0x0000000000000000}, // 5^5
+    {0xf424000000000000, 0x0000000000000000}, // 5^6
+    {0x9896800000000000, 0x0000000000000000}, // 5^7
+    {0xbebc200000000000, 0x0000000000000000}, // 5^8
+    {0xee6b280000000000, 0x0000000000000000}, // 5^9
+    {0x9502f90000000000, 0x0000000000000000}, // 5^10
+    {0xba43b74000000000, 0x0000000000000000}, // 5^11
+    {0xe8d4a51000000000, 0x0000000000000000}, // 5^12
+    {0x9184e72a00000000, 0x0000000000000000}, // 5^13
+    {0xb5e620f480000000, 0x0000000000000000}, // 5^14
+    {0xe35fa931a0000000, 0x0000000000000000}, // 5^15
+    {0x8e1bc9bf04000000, 0x0000000000000000}, // 5^16
+    {0xb1a2bc2ec5000000, 0x0000000000000000}, // 5^17
+    {0xde0b6b3a76400000, 0x0000000000000000}, // 5^18
+    {0x8ac7230489e80000, 0x0000000000000000}, // 5^19
+    {0xad78ebc5ac620000, 0x0000000000000000}, // 5^20
+    {0xd8d726b7177a8000, 0x0000000000000000}, // 5^21
+    {0x878678326eac9000, 0x0000000000000000}, // 5^22
+    {0xa968163f0a57b400, 0x0000000000000000}, // 5^23
+    {0xd3c21bcecceda100, 0x0000000000000000}, // 5^24
+    {0x84595161401484a0, 0x0000000000000000}, // 5^25
+    {0xa56fa5b99019a5c8, 0x0000000000000000}, // 5^26
+    {0xcecb8f27f4200f3a, 0x0000000000000000}, // 5^27
+    {0x813f3978f8940984, 0x4000000000000000}, // 5^28
+    {0xa18f07d736b90be5, 0x5000000000000000}, // 5^29
+    {0xc9f2c9cd04674ede, 0xa400000000000000}, // 5^30
+    {0xfc6f7c4045812296, 0x4d00000000000000}, // 5^31
+    {0x9dc5ada82b70b59d, 0xf020000000000000}, // 5^32
+    {0xc5371912364ce305, 0x6c28000000000000}, // 5^33
+    {0xf684df56c3e01bc6, 0xc732000000000000}, // 5^34
+    {0x9a130b963a6c115c, 0x3c7f400000000000}, // 5^35
+    {0xc097ce7bc90715b3, 0x4b9f100000000000}, // 5^36
+    {0xf0bdc21abb48db20, 0x1e86d40000000000}, // 5^37
+    {0x96769950b50d88f4, 0x1314448000000000}, // 5^38
+};
+
+static void multiply(uint64_t a, uint64_t b, uint64_t& hi, uint64_t& lo) { // 64x64->128 bit with 32x32->64 bit multiplications
+    uint64_t a_hi = a >> 32, a_lo = a % (1ull<<32);
+    uint64_t b_hi = b >> 32, b_lo = b % (1ull<<32);
+    uint64_t lolo = a_lo * b_lo;
+    uint64_t hilo = a_hi * b_lo + (lolo >> 32);
+    uint64_t lohi = a_lo * b_hi + hilo % (1ull<<32);
+    hi = a_hi * b_hi + (hilo >> 32) + (lohi >> 32);
+    lo = (lohi << 32) | (lolo % (1ull<<32));
+}
+
+static uint32_t eisel_lemire(uint64_t w, int q) { // binary32 bits of w * 10^q without the sign, w > 0
+    if (q < smallest_power) return 0;
+    if (q > largest_power)  return 0x7f800000;
+
+    int lz = std::countl_zero(w);
+    w <<= lz;
+    const Power5& power = powers_of_five[q - smallest_power];
+    uint64_t hi = 0, lo = 0;
+    multiply(w, power.hi, hi, lo);
+    constexpr uint64_t precision = ~0ull >> 26;  // 23 mantissa bits + 3
+    if ((hi & precision) == precision) {         // the low bits of the power may carry into the result
+        uint64_t hi2 = 0, lo2 = 0;
+        multiply(w, power.lo, hi2, lo2);
+        lo += hi2;
+        hi += lo < hi2;
+    }
+
+    int upperbit = int(hi >> 63);
+    uint64_t mantissa = hi >> (upperbit + 38);   // 24 bits + 1 rounding bit
+    int exponent = ((217706 * q) >> 16) + 63 + upperbit - lz + 127; // floor(log2(10^q)) + biased exponent
+
+    if (exponent <= 0) {                         // subnormal, ties are impossible at this scale
+        if (-exponent + 1 >= 64) return 0;
+        mantissa >>= -exponent + 1;
+        mantissa += mantissa % 2;
+        mantissa >>= 1;
+        return uint32_t(mantissa);               // may round up to the smallest normal
+    }
+
+    if (lo <= 1 && q >= -17 && q <= 10 && mantissa % 4 == 1 && (mantissa << (upperbit + 38)) == hi)
+        mantissa &= ~1ull;                       // exactly halfway, round to even
+    mantissa += mantissa % 2;
+    mantissa >>= 1;
+    if (mantissa >= (2u<<23)) {                  // renormalize if necessary
+        mantissa = 1u<<23;
+        exponent++;
+    }
+    if (exponent >= 255)                         // handle overflow
+        return 0x7f800000;
+    return uint32_t(exponent) << 23 | uint32_t(mantissa % (1u<<23));
+}
+
+struct BigInt {                                  // unsigned, 2048 bits are enough to compare 115 digits to a halfway point
+    uint32_t limbs[64] = {};                     // little-endian
+    int size = 0;
+
+    BigInt(uint64_t n) {
+        for (; n > 0; n >>= 32)
+            limbs[size++] = uint32_t(n);
+    }
+
+    void multiply_add(uint32_t k, uint32_t a) {
+        uint64_t carry = a;
+        for (int i=0; i<size; i++) {
+            carry += uint64_t(limbs[i]) * k;
+            limbs[i] = uint32_t(carry);
+            carry >>= 32;
+        }
+        if (carry) limbs[size++] = uint32_t(carry);
+    }
+
+    void pow5(int n) {
+        for (; n >= 13; n -= 13)                 // 5^13 < 2^32
+            multiply_add(1220703125, 0);
+        for (; n > 0; n--)
+            multiply_add(5, 0);
+    }
+
+    void shift(int n) {
+        if (!size) return;
+        int words = n / 32, bits = n % 32;
+        if (bits) {
+            limbs[size] = 0;
+            for (int i=size; i>0; i--)
+                limbs[i] = limbs[i] << bits | limbs[i-1] >> (32 - bits);
+            limbs[0] <<= bits;
+            size += limbs[size] != 0;
+        }
+        if (words) {
+            std::memmove(limbs + words, limbs, size * sizeof(uint32_t));
+            std::memset(limbs, 0, words * sizeof(uint32_t));
+            size += words;
+        }
+    }
+
+    friend int compare(const BigInt& a, const BigInt& b) {
+        if (a.size != b.size) return a.size < b.size ? -1 : 1;
+        for (int i=a.size-1; i>=0; i--)
+            if (a.limbs[i] != b.limbs[i]) return a.limbs[i] < b.limbs[i] ? -1 : 1;
+        return 0;
+    }
+};
+
+// digits in [first, last) (a radix dot may be in between) times 10^exponent is known to round to b or to the next float up:
+// compare all the significant digits with the halfway point (2m + 1) * 2^(e-24)
+static uint32_t compare_halfway(const char* first, const char* last, int exponent, uint32_t b) {
+    constexpr int max_digits = 114;              // enough to tell any halfway point apart from its neighbours
+    BigInt digits(0);
+    int n = 0;
+    bool sticky = false;
+    for (const char* p = first; p != last; p++) {
+        if (*p == '.') continue;
+        if (n < max_digits) {
+            digits.multiply_add(10, *p - '0');
+            n++;
+        } else
+            sticky |= *p != '0';
+    }
+    if (sticky) {                                // a nonzero tail only breaks ties
+        digits.multiply_add(10, 1);
+        n++;
+    }
+    exponent -= n;
+
+    TinyFloat f = TinyFloat::from_bits(b);
+    BigInt halfway(2ull * f.mantissa + 1);
+    int binary = f.exponent - 24;
+    if (exponent >= 0)                           // digits * 2^exponent * 5^exponent vs halfway * 2^binary
+        digits.pow5(exponent);
+    else
+        halfway.pow5(-exponent);
+    if (exponent >= binary)
+        digits.shift(exponent - binary);
+    else
+        halfway.shift(binary - exponent);
+
+    int c = compare(digits, halfway);
+    return b + (c > 0 || (c == 0 && b % 2));
+}
+
+static bool match(const char*& p, const char* last, const char* word) { // case-insensitive, p moves past the match
+    const char* q = p;
+    for (; *word; word++, q++)
+        if (q == last || (*q | 0x20) != *word) return false;
+    p = q;
+    return true;
+}
+
+static int digit(char c, int base) {             // -1 if c is not a digit in base 10 or 16
+    if (c >= '0' && c <= '9') return c - '0';
+    if (base == 16 && (c | 0x20) >= 'a' && (c | 0x20) <= 'f') return (c | 0x20) - 'a' + 10;
+    return -1;
+}
+
+static bool parse_exponent(const char*& p, const char* last, char marker, int& exponent) {
+    if (p == last || (*p | 0x20) != marker) return false;
+    const char* q = p + 1;
+    bool negative = q != last && *q == '-';
+    if (q != last && (*q == '-' || *q == '+')) q++;
+    if (q == last || digit(*q, 10) < 0) return false;
+    int n = 0;
+    for (; q != last && digit(*q, 10) >= 0; q++)
+        n = std::min(n * 10 + digit(*q, 10), 100000); // far beyond any finite value
+    exponent = negative ? -n : n;
+    p = q;
+    return true;
+}
+
+std::from_chars_result from_chars(const char* first, const char* last, TinyFloat& value, std::chars_format fmt) {
+    const char* p = first;
+    bool negative = p != last && *p == '-';
+    if (negative) p++;
+
+    if (match(p, last, "inf")) {
+        match(p, last, "inity");
+        value = TinyFloat::inf(negative);
+        return { p, std::errc() };
+    }
+    if (match(p, last, "nan")) {
+        const char* q = p;
+        if (q != last && *q == '(') {            // nan(n-char-sequence)
+            for (q++; q != last && (digit(*q, 10) >= 0 || ((*q | 0x20) >= 'a' && (*q | 0x20) <= 'z') || *q == '_'); q++);
+            if (q != last && *q == ')') p = q + 1;
+        }
+        value = TinyFloat::nan();
+        return { p, std::errc() };
+    }
+
+    int base = fmt == std::chars_format::hex ? 16 : 10;
+    uint64_t w = 0;                              // significant digits
+    int stored = 0;                              // number of digits in w (decimal)
+    int point = 0;                               // position of the radix dot relative to the first significant digit
+    int exponent = 0;                            // binary exponent of w (hex)
+    bool truncated = false, any = false;
+    const char* significant = nullptr;
+    for (bool fraction = false; p != last; p++) {
+        if (*p == '.' && !fraction) {
+            fraction = true;
+            continue;
+        }
+        int d = digit(*p, base);
+        if (d < 0) break;
+        any = true;
+        if (!significant && !d) {                // leading zero
+            point -= fraction;
+            exponent -= 4 * fraction;
+            continue;
+        }
+        if (!significant) significant = p;
+        point += !fraction;
+        if (base == 16) {
+            if (w < (1ull<<58)) {
+                w = w * 16 + d;
+                exponent -= 4 * fraction;
+            } else {
+                truncated |= d != 0;
+                exponent += 4 * !fraction;
+            }
+        } else if (stored < 19) {
+            w = w * 10 + d;
+            stored++;
+        } else
+            truncated |= d != 0;
+    }
+    if (!any)
+        return { first, std::errc::invalid_argument };
+    const char* end = p;
+
+    int e = 0;
+    if (base == 16)
+        parse_exponent(p, last, 'p', e);
+    else if (fmt != std::chars_format::fixed && !parse_exponent(p, last, 'e', e) && fmt == std::chars_format::scientific)
+        return { first, std::errc::invalid_argument };
+
+    TinyFloat result;
+    if (base == 16)
+        result = round_to_tinyfloat(negative, exponent + e, w | truncated);
+    else if (!w)
+        result = TinyFloat::zero(negative);
+    else {
+        int q = point + e - stored;
+        uint32_t bits = eisel_lemire(w, q);
+        if (truncated && bits != eisel_lemire(w + 1, q)) // the digits beyond the 19th matter
+            bits = compare_halfway(significant, end, point + e, bits);
+        result = TinyFloat::from_bits(bits | uint32_t(negative) << 31);
+    }
+
+    if (result.isinf() || (!result.mantissa && w))
+        return { p, std::errc::result_out_of_range };
+    value = result;
+    return { p, std::errc() };
+}
+
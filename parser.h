@@ -0,0 +1,11 @@
+#pragma once
+#include <charconv>
+#include "tinyfloat.h"
+
+// Parses text into a TinyFloat like std::from_chars does for float, without the host FPU and without allocations:
+// an optional minus sign, then decimal digits with an optional radix dot and exponent (e.g. "-1.5e-3"),
+// hexadecimal digits with an optional binary exponent when fmt is hex (e.g. "1.8p3", no 0x prefix),
+// or inf, infinity, nan, nan(chars) in any case. The result is correctly rounded (round-to-nearest, even-on-ties),
+// subnormals included. If it rounds to infinity or to zero, ec is result_out_of_range and value is left unmodified.
+std::from_chars_result from_chars(const char* first, const char* last, TinyFloat& value, std::chars_format fmt = std::chars_format::general);
+
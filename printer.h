@@ -1,11 +1,55 @@
+#pragma once
 #include <iostream>
 #include <cstdint>
+#include "tinyfloat.h"
+#include "smallfloat.h"
 
-struct Q128_149 {
-    int number[277] = {};
-    Q128_149(int offset, uint32_t n);
-    bool print(std::ostream& out, bool trailing=true, int carry=0, int digno=0) const;
+// Printing, apart from the freestanding core: link the tinyfloat library for these.
+std::ostream& operator<<(std::ostream& out, const TinyFloat& f);
+std::ostream& exact(std::ostream& out);     // operator<< prints the exact binary value (default), e.g. 0.100000001490116119384765625
+std::ostream& shortest(std::ostream& out);  // operator<< prints the shortest decimal that reads back to the same value, e.g. 0.1
+std::ostream& operator<<(std::ostream& out, const TinyFloatStats& s); // a table, one line per operator
+
+template <int e, int m>
+std::ostream& operator<<(std::ostream& out, const SmallFloat<e, m>& f) {
+    return out << TinyFloat(f);
+}
+
+struct BigDecimal {                 // unsigned integer in base 10^9, wide enough for m * 5^1074 with a 64-bit m
+    static constexpr int capacity = 90;
+    uint32_t limbs[capacity];       // little-endian
+    int size = 0;
+    BigDecimal(uint64_t n);
+    void multiply(uint32_t k);
+};
+
+struct ExactDecimal {                          // exact decimal expansion of mantissa * 2^exponent = digits * 10^-point
+    char text[9 * BigDecimal::capacity + 1];   // one spare char in front of the digits for a rounding carry
+    char* digits;                              // most significant first, no leading zeros
+    int size;                                  // number of digits, 0 for zero
+    int point;                                 // number of digits after the radix dot
+    ExactDecimal(uint64_t mantissa, int exponent);
+};
+
+struct DecimalDigits {                         // decimal digits of mantissa * 2^exponent produced on demand, for printing with a precision
+    static constexpr int capacity = 36;        // 32-bit limbs of the binary fraction, enough for 2^-1074 and a 64-bit mantissa
+    char text[9 * BigDecimal::capacity + 2];   // one spare char in front for a rounding carry
+    char* digits = text + 1;                   // most significant first
+    int size = 0;                              // number of digits, 0 for zero
+    int q = 0;                                 // power of 10 of the last digit
+    int top = 0;                               // power of 10 of the first nonzero digit
+
+    BigDecimal whole;                          // integer part, converted at once
+    uint32_t fraction[capacity];               // fraction part: fraction / 2^(32 * limbs), little-endian
+    int limbs = 0, low = 0, used = 0;          // the nonzero limbs are in [low, used)
+    char block[9];                             // the last nine fraction digits computed
+    int taken = 9, nonzero = 9;                // how many of them are taken, and the end of the nonzero ones
+
+    DecimalDigits(uint64_t mantissa, int exponent);
+    void generate(int lowest);                 // digits from 10^top down to 10^lowest (or until the rest is zero), then
+                                               // a sticky '1' if anything nonzero is left below, call it once
+    void next_block();                         // nine more fraction digits
 };
 
-std::ostream& operator<<(std::ostream& out, const Q128_149& f);
+void print_exact(std::ostream& out, uint64_t mantissa, int exponent); // exact decimal expansion of mantissa * 2^exponent
 
@@ -0,0 +1,158 @@
+#include <algorithm>
+#include "shortest.h"
+
+// Ryu for binary32 (U. Adams, "Ryu: fast float-to-string conversion", PLDI 2018): the halfway points to the
+// neighbouring floats are scaled by a power of 10 with a single 32x64-bit multiplication each, using truncated
+// 2^k/5^q and 5^q tables, then decimal digits are removed while the interval still tells the value apart.
+
+static constexpr int pow5_inv_bits = 59;
+static constexpr int pow5_bits     = 61;
+
+static constexpr uint64_t pow5_inv_split[31] = { // floor(2^(pow5bits(q) - 1 + 59) / 5^q) + 1
+    576460752303423489, 461168601842738791, 368934881474191033, 295147905179352826,
+    472236648286964522, 377789318629571618, 302231454903657294, 483570327845851670,
+    386856262276681336, 309485009821345069, 495176015714152110, 396140812571321688,
+    316912650057057351, 507060240091291761, 405648192073033409, 324518553658426727,
+    519229685853482763, 415383748682786211, 332306998946228969, 531691198313966350,
+    425352958651173080, 340282366920938464, 544451787073501542, 435561429658801234,
+    348449143727040987, 557518629963265579, 446014903970612463, 356811923176489971,
+    570899077082383953, 456719261665907162, 365375409332725730,
+};
+
+static constexpr uint64_t pow5_split[47] = {     // 5^q truncated to 61 bits
+    1152921504606846976, 1441151880758558720, 1801439850948198400, 2251799813685248000,
+    1407374883553280000, 1759218604441600000, 2199023255552000000, 1374389534720000000,
+    1717986918400000000, 2147483648000000000, 1342177280000000000, 1677721600000000000,
+    2097152000000000000, 1310720000000000000, 1638400000000000000, 2048000000000000000,
+    1280000000000000000, 1600000000000000000, 2000000000000000000, 1250000000000000000,
+    1562500000000000000, 1953125000000000000, 1220703125000000000, 1525878906250000000,
+    1907348632812500000, 1192092895507812500, 1490116119384765625, 1862645149230957031,
+    1164153218269348144, 1455191522836685180, 1818989403545856475, 2273736754432320594,
+    1421085471520200371, 1776356839400250464, 2220446049250313080, 1387778780781445675,
+    1734723475976807094, 2168404344971008868, 1355252715606880542, 1694065894508600678,
+    2117582368135750847, 1323488980084844279, 1654361225106055349, 2067951531382569187,
+    1292469707114105741, 1615587133892632177, 2019483917365790221,
+};
+
+static int pow5bits(int e) { return ((e * 1217359) >> 19) + 1; } // ceil(log2(5^e)), 1 for e = 0
+static int log10_pow2(int e) { return (e * 78913) >> 18; }       // floor(log10(2^e))
+static int log10_pow5(int e) { return (e * 732923) >> 20; }      // floor(log10(5^e))
+
+static bool multiple_of_pow5(uint32_t value, int p) {
+    int count = 0;
+    for (; value % 5 == 0; value /= 5)
+        count++;
+    return count >= p;
+}
+
+static bool multiple_of_pow2(uint32_t value, int p) {
+    return value % (1u<<p) == 0;
+}
+
+static uint32_t multiply_shift(uint32_t m, uint64_t factor, int shift) { // (m * factor) >> shift, shift > 32
+    uint64_t lo = uint64_t(m) * uint32_t(factor);
+    uint64_t hi = uint64_t(m) * uint32_t(factor >> 32);
+    return uint32_t(((lo >> 32) + hi) >> (shift - 32));
+}
+
+ShortestDecimal shortest_decimal(const TinyFloat& f) {
+    uint32_t bits = f.bits();
+    uint32_t raw_exponent = (bits >> 23) % 256;
+    uint32_t raw_mantissa = bits % (1u<<23);
+    if (!raw_exponent && !raw_mantissa)
+        return { f.negative, 0, 0 };
+
+    int e2 = int(std::max(raw_exponent, 1u)) - 127 - 23 - 2; // the value is m2 * 2^(e2+2)
+    uint32_t m2 = raw_exponent ? raw_mantissa + (1u<<23) : raw_mantissa;
+    bool even = m2 % 2 == 0;                     // round-to-even: the halfway points themselves read back to f
+
+    uint32_t mv = 4 * m2;                        // the value and the halfway points to its neighbours, times 4
+    uint32_t mp = 4 * m2 + 2;
+    uint32_t mm_shift = raw_mantissa != 0 || raw_exponent <= 1; // the gap below is narrower at powers of 2
+    uint32_t mm = 4 * m2 - 1 - mm_shift;
+
+    uint32_t vr = 0, vp = 0, vm = 0;             // the same, scaled to decimal: v * 2^e2 / 10^e10
+    int e10 = 0;
+    bool vm_trailing_zeros = false, vr_trailing_zeros = false;
+    uint32_t last_removed = 0;
+    if (e2 >= 0) {
+        int q = log10_pow2(e2);
+        e10 = q;
+        int k = pow5_inv_bits + pow5bits(q) - 1;
+        int i = -e2 + q + k;
+        vr = multiply_shift(mv, pow5_inv_split[q], i);
+        vp = multiply_shift(mp, pow5_inv_split[q], i);
+        vm = multiply_shift(mm, pow5_inv_split[q], i);
+        if (q != 0 && (vp - 1) / 10 <= vm / 10) { // one more digit is needed to round vr
+            int l = pow5_inv_bits + pow5bits(q - 1) - 1;
+            last_removed = multiply_shift(mv, pow5_inv_split[q - 1], -e2 + q - 1 + l) % 10;
+        }
+        if (q <= 9) {                            // only one of mv, mp, mm may be a multiple of 5
+            if (mv % 5 == 0)
+                vr_trailing_zeros = multiple_of_pow5(mv, q);
+            else if (even)
+                vm_trailing_zeros = multiple_of_pow5(mm, q);
+            else
+                vp -= multiple_of_pow5(mp, q);
+        }
+    } else {
+        int q = log10_pow5(-e2);
+        e10 = q + e2;
+        int i = -e2 - q;
+        int k = pow5bits(i) - pow5_bits;
+        int j = q - k;
+        vr = multiply_shift(mv, pow5_split[i], j);
+        vp = multiply_shift(mp, pow5_split[i], j);
+        vm = multiply_shift(mm, pow5_split[i], j);
+        if (q != 0 && (vp - 1) / 10 <= vm / 10) {
+            j = q - 1 - (pow5bits(i + 1) - pow5_bits);
+            last_removed = multiply_shift(mv, pow5_split[i + 1], j) % 10;
+        }
+        if (q <= 1) {                            // mv has at least 2 trailing zero bits
+            vr_trailing_zeros = true;
+            if (even)
+                vm_trailing_zeros = mm_shift == 1;
+            else
+                vp--;
+        } else if (q < 31)
+            vr_trailing_zeros = multiple_of_pow2(mv, q - 1);
+    }
+
+    int removed = 0;                             // remove digits while vm and vp stay apart
+    uint32_t output = 0;
+    if (vm_trailing_zeros || vr_trailing_zeros) { // rare: the bounds or the value are exact in decimal
+        for (; vp / 10 > vm / 10; removed++) {
+            vm_trailing_zeros &= vm % 10 == 0;
+            vr_trailing_zeros &= last_removed == 0;
+            last_removed = vr % 10;
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+        }
+        if (vm_trailing_zeros)
+            for (; vm % 10 == 0; removed++) {
+                vr_trailing_zeros &= last_removed == 0;
+                last_removed = vr % 10;
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+            }
+        if (vr_trailing_zeros && last_removed == 5 && vr % 2 == 0) // exactly ...50..0, round to even
+            last_removed = 4;
+        output = vr + ((vr == vm && (!even || !vm_trailing_zeros)) || last_removed >= 5);
+    } else {
+        for (; vp / 10 > vm / 10; removed++) {
+            last_removed = vr % 10;
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+        }
+        output = vr + (vr == vm || last_removed >= 5);
+    }
+
+    int exponent = e10 + removed;
+    for (; output % 10 == 0; output /= 10)
+        exponent++;
+    return { f.negative, output, exponent };
+}
+
@@ -0,0 +1,13 @@
+#pragma once
+#include "tinyfloat.h"
+
+// The shortest decimal that reads back to the same TinyFloat: significand * 10^exponent,
+// when several decimals of that length qualify, the one nearest to the exact value is chosen.
+struct ShortestDecimal {
+    bool     negative = false;
+    uint32_t significand = 0;     // at most 9 digits, no trailing zeros
+    int      exponent = 0;
+};
+
+ShortestDecimal shortest_decimal(const TinyFloat& f); // f must be finite
+
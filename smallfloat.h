@@ -0,0 +1,115 @@
+#pragma once
+#include <type_traits>
+#include "tinyfloat.h"
+
+// IEEE 754-like formats with ebits exponent bits and mbits explicit mantissa bits, stored in 8 or 16 bits:
+// binary16, bfloat16, FP8 and the like. All of them share the TinyFloat arithmetic: the operands are widened
+// to TinyFloat (exactly), the operation is computed there, and the result is rounded once to the narrow format.
+// binary32 carries at least 2*(mbits+1)+2 bits of precision and covers the exponent range of these formats,
+// so the double rounding is innocuous and +, -, *, / and sqrt are correctly rounded
+// (S. Figueroa, "When is double rounding innocuous?", 1995).
+template <int ebits, int mbits>
+struct SmallFloat {
+    static_assert(ebits >= 2 && ebits <= 8 && mbits >= 1 && 2*(mbits+1)+2 <= 24, "the format must fit in binary32 with enough guard bits");
+    using storage = std::conditional_t<1+ebits+mbits <= 8, uint8_t, uint16_t>;
+
+    static constexpr int bias = (1<<(ebits-1)) - 1;
+    static constexpr int emin = 1 - bias;      // exponent of the smallest normal number
+    static constexpr int emax = bias;          // exponent of the largest finite number
+
+    storage bits = 0;                          // sign | biased exponent | mantissa
+
+    constexpr SmallFloat() = default;
+    constexpr SmallFloat(const TinyFloat& f);  // round-to-nearest, even-on-ties
+    constexpr operator TinyFloat() const;      // exact
+
+    static constexpr SmallFloat from_bits(storage u) { SmallFloat f; f.bits = u; return f; }
+};
+
+using Binary16    = SmallFloat<5, 10>;         // IEEE 754 half precision
+using BFloat16    = SmallFloat<8,  7>;         // binary32 with a truncated mantissa
+using FP8E5M2     = SmallFloat<5,  2>;
+using FP8E4M3IEEE = SmallFloat<4,  3>;         // keeps inf, so its range ends at 240: not the E4M3FN of OCP (no inf, max 448)
+
+template <int ebits, int mbits>
+constexpr SmallFloat<ebits, mbits>::SmallFloat(const TinyFloat& f) {
+    storage sign = storage(f.negative) << (ebits + mbits);
+    storage infinity = storage(((1u<<ebits) - 1) << mbits);
+    if (f.isnan()) {                           // quiet nan, the payload is lost
+        bits = sign | infinity | (1u<<(mbits-1));
+        return;
+    }
+    if (f.isinf() || !f.mantissa) {
+        bits = sign | (f.isinf() ? infinity : 0);
+        return;
+    }
+
+    int exponent = f.exponent;
+    uint32_t mantissa = f.mantissa;
+    int lz = std::countl_zero(mantissa) - 8;   // normalize subnormals
+    mantissa <<= lz;
+    exponent -= lz;
+
+    int target = exponent > emin ? exponent : emin; // subnormal in the narrow format?
+    int shift = 23 - mbits + target - exponent;
+    uint32_t remainder = 0, half = 0;
+    if (shift < 32) {
+        remainder = mantissa % (1u<<shift);
+        half = 1u<<(shift-1);
+        mantissa >>= shift;
+    } else {
+        remainder = mantissa;                  // everything goes to the sticky part
+        half = 1u<<31;
+        mantissa = 0;
+    }
+
+    if (remainder > half || (remainder == half && mantissa % 2)) { // round-to-nearest, even-on-ties
+        mantissa++;
+        if (mantissa == (1u<<(mbits+1))) {     // renormalize if necessary
+            mantissa /= 2;
+            target++;
+        }
+    }
+
+    if (target > emax) {                       // handle overflow
+        bits = sign | infinity;
+        return;
+    }
+
+    uint32_t biased = mantissa < (1u<<mbits) ? 0 : target + bias;
+    bits = sign | storage(biased << mbits) | storage(mantissa % (1u<<mbits));
+}
+
+template <int ebits, int mbits>
+constexpr SmallFloat<ebits, mbits>::operator TinyFloat() const {
+    bool     negative = bits >> (ebits + mbits);
+    uint32_t biased   = (bits >> mbits) % (1u<<ebits);
+    uint32_t mantissa = (bits % (1u<<mbits)) << (23 - mbits);
+
+    if (biased == (1u<<ebits) - 1)             // nan or inf
+        return mantissa ? TinyFloat::nan() : TinyFloat::inf(negative);
+    if (!biased && !mantissa)
+        return TinyFloat::zero(negative);
+
+    int exponent = emin;
+    if (biased) {                              // normal, recover the hidden bit = 1
+        exponent = int(biased) - bias;
+        mantissa += 1u<<23;
+    } else {                                   // subnormal in the narrow format, normal in binary32
+        int lz = std::countl_zero(mantissa) - 8;
+        lz = lz < exponent + 126 ? lz : exponent + 126;
+        mantissa <<= lz;
+        exponent -= lz;
+    }
+    return { negative, int16_t(exponent), mantissa };
+}
+
+template <int e, int m> constexpr SmallFloat<e, m> operator+(const SmallFloat<e, m>& lhs, const SmallFloat<e, m>& rhs) { return TinyFloat(lhs) + TinyFloat(rhs); }
+template <int e, int m> constexpr SmallFloat<e, m> operator-(const SmallFloat<e, m>& lhs, const SmallFloat<e, m>& rhs) { return TinyFloat(lhs) - TinyFloat(rhs); }
+template <int e, int m> constexpr SmallFloat<e, m> operator*(const SmallFloat<e, m>& lhs, const SmallFloat<e, m>& rhs) { return TinyFloat(lhs) * TinyFloat(rhs); }
+template <int e, int m> constexpr SmallFloat<e, m> operator/(const SmallFloat<e, m>& lhs, const SmallFloat<e, m>& rhs) { return TinyFloat(lhs) / TinyFloat(rhs); }
+template <int e, int m> constexpr SmallFloat<e, m> operator-(const SmallFloat<e, m>& f) { return -TinyFloat(f); }
+template <int e, int m> constexpr SmallFloat<e, m> sqrt(const SmallFloat<e, m>& f) { return sqrt(TinyFloat(f)); }
+
+// comparisons go through the implicit conversion to TinyFloat, it is exact
+
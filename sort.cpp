@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+#include "sort.h"
+
+template <typename T>
+static void radix_sort(std::span<T> values) {
+    size_t n = values.size();
+    std::vector<uint32_t> keys(n), buffer(n);
+    for (size_t i=0; i<n; i++)
+        keys[i] = sort_key(values[i]);
+
+    if (n < 256)                                   // the histograms do not pay off
+        std::sort(keys.begin(), keys.end());
+    else {
+        constexpr int passes = 3, radix = 11;      // 11 + 11 + 10 bits, the counters fit in L1
+        std::vector<size_t> counts(passes << radix);
+        for (uint32_t key : keys)                  // all the histograms in one go
+            for (int p=0; p<passes; p++)
+                counts[(p << radix) + ((key >> (p*radix)) % (1u<<radix))]++;
+
+        for (int p=0; p<passes; p++) {
+            size_t* count = &counts[p << radix];
+            if (count[(keys[0] >> (p*radix)) % (1u<<radix)] == n) // same digit everywhere, nothing to do
+                continue;
+            size_t sum = 0;
+            for (int d=0; d<(1<<radix); d++)       // bucket offsets
+                sum += std::exchange(count[d], sum);
+            for (uint32_t key : keys)
+                buffer[count[(key >> (p*radix)) % (1u<<radix)]++] = key;
+            keys.swap(buffer);
+        }
+    }
+
+    for (size_t i=0; i<n; i++)
+        values[i] = from_sort_key(keys[i]);
+}
+
+void sort(std::span<TinyFloat> values) {
+    radix_sort(values);
+}
+
+void sort(std::span<PackedFloat> values) {
+    radix_sort(values);
+}
+
+template <typename T, typename Op>
+static PackedFloat reduce(std::span<const T> values, Op op) {
+    assert(!values.empty());
+    uint32_t key = sort_key(values[0]);
+    for (const T& f : values)
+        key = op(key, sort_key(f));
+    return from_sort_key(key);
+}
+
+TinyFloat min(std::span<const TinyFloat> values) {
+    return reduce(values, [](uint32_t x, uint32_t y) { return std::min(x, y); });
+}
+
+TinyFloat max(std::span<const TinyFloat> values) {
+    return reduce(values, [](uint32_t x, uint32_t y) { return std::max(x, y); });
+}
+
+PackedFloat min(std::span<const PackedFloat> values) {
+    return reduce(values, [](uint32_t x, uint32_t y) { return std::min(x, y); });
+}
+
+PackedFloat max(std::span<const PackedFloat> values) {
+    return reduce(values, [](uint32_t x, uint32_t y) { return std::max(x, y); });
+}
+
+template <typename T>
+static void clamp_keys(std::span<const T> a, const TinyFloat& lo, const TinyFloat& hi, std::span<T> out) {
+    assert(a.size() == out.size());
+    uint32_t lo_key = sort_key(lo), hi_key = sort_key(hi);
+    assert(lo_key <= hi_key);
+    for (size_t i=0; i<out.size(); i++)
+        out[i] = from_sort_key(std::clamp(sort_key(a[i]), lo_key, hi_key));
+}
+
+void clamp(std::span<const TinyFloat> a, const TinyFloat& lo, const TinyFloat& hi, std::span<TinyFloat> out) {
+    clamp_keys(a, lo, hi, out);
+}
+
+void clamp(std::span<const PackedFloat> a, const TinyFloat& lo, const TinyFloat& hi, std::span<PackedFloat> out) {
+    clamp_keys(a, lo, hi, out);
+}
+
@@ -0,0 +1,36 @@
+#pragma once
+#include <span>
+#include "tinyfloat.h"
+#include "packed.h"
+
+// IEEE 754 totalOrder: -nan < -inf < ... < -0 < +0 < ... < +inf < +nan.
+// sort_key maps a value to an unsigned integer that is monotone in this order, so a single integer comparison
+// replaces the comparison operators: the bits of negative values are flipped, positive values get the sign bit set.
+constexpr uint32_t sort_key(PackedFloat f) {
+    return f.bits >> 31 ? ~f.bits : f.bits | (1u<<31);
+}
+
+constexpr uint32_t sort_key(const TinyFloat& f) {
+    return sort_key(PackedFloat(f));
+}
+
+constexpr PackedFloat from_sort_key(uint32_t key) {
+    PackedFloat f;
+    f.bits = key >> 31 ? key & ~(1u<<31) : ~key;
+    return f;
+}
+
+// Ascending sort in the total order above, it is an LSD radix sort over the keys.
+void sort(std::span<TinyFloat>   values);
+void sort(std::span<PackedFloat> values);
+
+// Smallest/largest element of a non-empty span in the total order: a nan with the sign bit set is below everything,
+// a positive one is above everything. clamp restricts every element to [lo, hi] in the same order.
+TinyFloat min(std::span<const TinyFloat> values);
+TinyFloat max(std::span<const TinyFloat> values);
+PackedFloat min(std::span<const PackedFloat> values);
+PackedFloat max(std::span<const PackedFloat> values);
+
+void clamp(std::span<const TinyFloat>   a, const TinyFloat& lo, const TinyFloat& hi, std::span<TinyFloat>   out);
+void clamp(std::span<const PackedFloat> a, const TinyFloat& lo, const TinyFloat& hi, std::span<PackedFloat> out);
+
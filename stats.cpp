@@ -0,0 +1,94 @@
+#include <iostream>
+#include <iomanip>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+#include "printer.h"
+
+#ifdef TINYFLOAT_STATS
+struct Registry {
+    std::mutex lock;
+    std::vector<StatsBlock*> blocks;           // the threads alive
+    uint64_t retired[int(Counted::count)][int(Counter::count)] = {}; // the counts of the threads gone
+};
+
+static Registry& registry() {                  // constructed on first use, the operators may run in static initializers
+    static Registry r;
+    return r;
+}
+
+struct Enrollment {                            // folds the counts of a thread into the registry when the thread ends
+    StatsBlock* block = nullptr;
+    ~Enrollment() {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> guard(r.lock);
+        for (int op=0; op<int(Counted::count); op++)
+            for (int c=0; c<int(Counter::count); c++)
+                r.retired[op][c] += block->counts[op][c].load(std::memory_order_relaxed);
+        r.blocks.erase(std::find(r.blocks.begin(), r.blocks.end(), block));
+    }
+};
+
+void StatsBlock::enroll() {
+    static thread_local Enrollment enrollment;
+    Registry& r = registry();
+    std::lock_guard<std::mutex> guard(r.lock);
+    enrollment.block = this;
+    r.blocks.push_back(this);
+    enrolled = true;
+}
+
+TinyFloatStats tinyfloat_stats() {
+    uint64_t sum[int(Counted::count)][int(Counter::count)];
+    Registry& r = registry();
+    {
+        std::lock_guard<std::mutex> guard(r.lock);
+        for (int op=0; op<int(Counted::count); op++)
+            for (int c=0; c<int(Counter::count); c++) {
+                sum[op][c] = r.retired[op][c];
+                for (StatsBlock* block : r.blocks)
+                    sum[op][c] += block->counts[op][c].load(std::memory_order_relaxed);
+            }
+    }
+    TinyFloatStats s;
+    for (int op=0; op<int(Counted::count); op++)
+        s.op[op] = { sum[op][0], sum[op][1], sum[op][2], sum[op][3], sum[op][4],
+                     { sum[op][5], sum[op][6], sum[op][7], sum[op][8], sum[op][9], sum[op][10] } };
+    return s;
+}
+
+void reset_tinyfloat_stats() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> guard(r.lock);
+    for (int op=0; op<int(Counted::count); op++)
+        for (int c=0; c<int(Counter::count); c++) {
+            r.retired[op][c] = 0;
+            for (StatsBlock* block : r.blocks)  // the other threads may lose an increment or two meanwhile
+                block->counts[op][c].store(0, std::memory_order_relaxed);
+        }
+}
+#else
+TinyFloatStats tinyfloat_stats() {
+    return {};
+}
+
+void reset_tinyfloat_stats() {}
+#endif
+
+std::ostream& operator<<(std::ostream& out, const TinyFloatStats& s) {
+    const char* names[int(Counted::count)] = { "add", "mul", "div", "fma", "sqrt", "compare", "convert" };
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::left << std::setw(8) << "op" << std::right << std::setw(14) << "calls" << std::setw(14) << "special"
+        << std::setw(14) << "subnormal" << std::setw(14) << "iterations" << std::setw(14) << "rounding" << std::setw(12) << "iter/call" << '\n';
+    for (int op=0; op<int(Counted::count); op++) {
+        const OperatorStats& o = s.op[op];
+        out << std::left << std::setw(8) << names[op] << std::right << std::setw(14) << o.calls << std::setw(14) << o.special
+            << std::setw(14) << o.subnormal << std::setw(14) << o.iterations << std::setw(14) << o.rounding << std::setw(12)
+            << std::fixed << std::setprecision(2) << (o.calls ? double(o.iterations) / o.calls : 0.) << '\n';
+    }
+    out.flags(flags);
+    out.precision(precision);
+    return out;
+}
+
@@ -0,0 +1,277 @@
+#pragma once
+#include <cstdint>
+#include <bit>
+#include <concepts>
+#include <type_traits>
+
+// Hot-path counters of the operators, compiled in only with TINYFLOAT_STATS defined (cmake -DTINYFLOAT_STATS=ON),
+// otherwise TINYFLOAT_SCOPE, TINYFLOAT_COUNT and TINYFLOAT_TALLY expand to nothing, Tallied<T> is T and
+// tinyfloat_stats() returns zeros. Every thread counts in a block of its own without synchronization,
+// tinyfloat_stats() sums the blocks of all the threads. Constant evaluation is not counted. TINYFLOAT_TALLY counts
+// for the operator running, if any: round_to_tinyfloat counts its rounding for fma but not for the parser. fma with a zero operand hands the work over to operator+
+// or operator*, so such a call is counted once as an fma call and once more by the operator that computes it.
+enum class Counted { add, mul, div, fma, sqrt, compare, convert, count }; // operator- is counted as operator+
+enum class Counter { calls, special, subnormal, iterations, rounding, shift, add, mul, div, clz, branch, count };
+
+// The integer primitives executed on a 32-bit target. The fields of TinyFloat and the integers of the operators
+// are Tallied: every operation on them tallies itself for the operator running, the innermost TINYFLOAT_SCOPE.
+// shift counts <<, >>, and * and / by a power of two constant; add counts +, -, logic, comparisons, and % by a
+// power of two constant; mul and div count the other *, / and %; clz counts tinyfloat_clz; branch counts the
+// comparisons and the integers tested as conditions. 64-bit operations count twice. Moves, conversions between
+// integer types and the logic on bool are not counted.
+struct IntegerOps {
+    uint64_t shift  = 0;
+    uint64_t add    = 0;
+    uint64_t mul    = 0;
+    uint64_t div    = 0;
+    uint64_t clz    = 0;
+    uint64_t branch = 0;
+};
+
+struct OperatorStats {
+    uint64_t calls      = 0;
+    uint64_t special    = 0;   // early exits on nan, inf and zero operands (nan and inf only for fma)
+    uint64_t subnormal  = 0;   // calls with subnormal operands, or a subnormal result but for operator+
+    uint64_t iterations = 0;   // loop iterations, and bit positions crossed by the single shifts of operator+ and fma
+    uint64_t rounding   = 0;   // round-to-nearest increments
+    IntegerOps ops;            // the primitives executed
+};
+
+struct TinyFloatStats {
+    OperatorStats op[int(Counted::count)];
+    const OperatorStats& operator[](Counted c) const { return op[int(c)]; }
+};
+
+TinyFloatStats tinyfloat_stats();       // the sum over all the threads so far
+void reset_tinyfloat_stats();  // zeroes the counters of all the threads
+
+template <std::unsigned_integral T>
+constexpr int tinyfloat_clz(T x) { return std::countl_zero(x); }
+
+#ifdef TINYFLOAT_STATS
+#include <atomic>
+
+struct StatsBlock {            // written by its thread only, relaxed atomics let the others read it
+    std::atomic<uint64_t> counts[int(Counted::count)][int(Counter::count)];
+    int scope = -1;            // the operator running on this thread, -1 outside of the operators
+    bool enrolled = false;
+    void enroll();             // registers the block, once per thread
+};
+
+inline constinit thread_local StatsBlock stats_block;
+
+inline void tinyfloat_count(Counted op, Counter counter, uint64_t n) {
+    StatsBlock& block = stats_block;
+    if (!block.enrolled) [[unlikely]]
+        block.enroll();
+    std::atomic<uint64_t>& c = block.counts[int(op)][int(counter)];
+    c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed); // no read-modify-write needed
+}
+
+inline void tinyfloat_tally(Counter counter, uint64_t n) { // a primitive of the operator running, if any
+    int scope = stats_block.scope;
+    if (scope >= 0)
+        tinyfloat_count(Counted(scope), counter, n);
+}
+
+template <typename F>
+void tinyfloat_count_quietly(Counted op, Counter counter, F n) { // the primitives that compute n are not tallied
+    StatsBlock& block = stats_block;
+    int scope = block.scope;
+    block.scope = -1;
+    uint64_t value = n();
+    block.scope = scope;
+    tinyfloat_count(op, counter, value);
+}
+
+struct StatsScope {            // the operator running until the end of the block, a nested call of the same one is a part of it
+    int outer = -1;
+    constexpr explicit StatsScope(Counted op) {
+        if (std::is_constant_evaluated())
+            return;
+        outer = stats_block.scope;
+        stats_block.scope = int(op);
+        if (outer != int(op))
+            tinyfloat_count(op, Counter::calls, 1);
+    }
+    constexpr ~StatsScope() {
+        if (!std::is_constant_evaluated())
+            stats_block.scope = outer;
+    }
+};
+
+template <std::integral T>
+struct TalliedInt;
+
+template <typename T> inline constexpr bool is_tallied = false;
+template <typename T> inline constexpr bool is_tallied<TalliedInt<T>> = true;
+
+template <typename T>
+concept TalliedOperand = std::integral<T> || is_tallied<T>;
+
+template <typename L, typename R>
+concept TalliedOperands = TalliedOperand<L> && TalliedOperand<R> && (is_tallied<L> || is_tallied<R>);
+
+template <typename T>
+constexpr auto untallied(T x) {
+    if constexpr (is_tallied<T>) return x.value; else return x;
+}
+
+template <typename T>
+constexpr bool power_of_two_constant(T x) { // an untallied operand is a constant of the code
+    if constexpr (is_tallied<T>) return false; else return x > 0 && std::has_single_bit(std::make_unsigned_t<T>(x));
+}
+
+template <std::integral T>
+constexpr void tally(Counter counter, uint64_t n = 1) {
+    if (!std::is_constant_evaluated())
+        tinyfloat_tally(counter, sizeof(T) > 4 ? 2*n : n);
+}
+
+template <std::integral T>
+struct TalliedInt {
+    T value = 0;
+
+    constexpr TalliedInt() = default;
+    constexpr TalliedInt(T v) : value(v) {}
+    template <std::integral U> constexpr TalliedInt(TalliedInt<U> v) : value(T(v.value)) {}
+
+    template <std::integral U> constexpr operator U() const { // a condition is a branch
+        if constexpr (std::same_as<U, bool>)
+            tally<T>(Counter::branch);
+        return U(value);
+    }
+
+    template <TalliedOperand R> constexpr TalliedInt& operator+=(R r)  { return *this = *this + r; }
+    template <TalliedOperand R> constexpr TalliedInt& operator-=(R r)  { return *this = *this - r; }
+    template <TalliedOperand R> constexpr TalliedInt& operator*=(R r)  { return *this = *this * r; }
+    template <TalliedOperand R> constexpr TalliedInt& operator/=(R r)  { return *this = *this / r; }
+    template <TalliedOperand R> constexpr TalliedInt& operator%=(R r)  { return *this = *this % r; }
+    template <TalliedOperand R> constexpr TalliedInt& operator<<=(R r) { return *this = *this << r; }
+    template <TalliedOperand R> constexpr TalliedInt& operator>>=(R r) { return *this = *this >> r; }
+    template <TalliedOperand R> constexpr TalliedInt& operator&=(R r)  { return *this = *this & r; }
+    template <TalliedOperand R> constexpr TalliedInt& operator|=(R r)  { return *this = *this | r; }
+    constexpr TalliedInt& operator++() { tally<T>(Counter::add); ++value; return *this; }
+    constexpr TalliedInt& operator--() { tally<T>(Counter::add); --value; return *this; }
+    constexpr TalliedInt operator++(int) { TalliedInt old = *this; ++*this; return old; }
+    constexpr TalliedInt operator--(int) { TalliedInt old = *this; --*this; return old; }
+};
+
+template <Counter counter, typename V>
+constexpr TalliedInt<V> tallied(V v) {
+    tally<V>(counter);
+    return v;
+}
+
+template <typename L, typename R> requires TalliedOperands<L, R>
+constexpr auto operator+(L l, R r) { return tallied<Counter::add>(untallied(l) + untallied(r)); }
+template <typename L, typename R> requires TalliedOperands<L, R>
+constexpr auto operator-(L l, R r) { return tallied<Counter::add>(untallied(l) - untallied(r)); }
+template <typename L, typename R> requires TalliedOperands<L, R>
+constexpr auto operator&(L l, R r) { return tallied<Counter::add>(untallied(l) & untallied(r)); }
+template <typename L, typename R> requires TalliedOperands<L, R>
+constexpr auto operator|(L l, R r) { return tallied<Counter::add>(untallied(l) | untallied(r)); }
+template <typename L, typename R> requires TalliedOperands<L, R>
+constexpr auto operator^(L l, R r) { return tallied<Counter::add>(untallied(l) ^ untallied(r)); }
+template <typename L, typename R> requires TalliedOperands<L, R>
+constexpr auto operator<<(L l, R r) { return tallied<Counter::shift>(untallied(l) << untallied(r)); }
+template <typename L, typename R> requires TalliedOperands<L, R>
+constexpr auto operator>>(L l, R r) { return tallied<Counter::shift>(untallied(l) >> untallied(r)); }
+
+template <typename L, typename R> requires TalliedOperands<L, R>
+constexpr auto operator*(L l, R r) {
+    if (power_of_two_constant(l) || power_of_two_constant(r))
+        return tallied<Counter::shift>(untallied(l) * untallied(r));
+    return tallied<Counter::mul>(untallied(l) * untallied(r));
+}
+
+template <typename L, typename R> requires TalliedOperands<L, R>
+constexpr auto operator/(L l, R r) {
+    if (power_of_two_constant(r))
+        return tallied<Counter::shift>(untallied(l) / untallied(r));
+    return tallied<Counter::div>(untallied(l) / untallied(r));
+}
+
+template <typename L, typename R> requires TalliedOperands<L, R>
+constexpr auto operator%(L l, R r) {
+    if (power_of_two_constant(r))
+        return tallied<Counter::add>(untallied(l) % untallied(r));
+    return tallied<Counter::div>(untallied(l) % untallied(r));
+}
+
+template <std::integral L, typename R> requires is_tallied<R>
+constexpr L& operator+=(L& l, R r) { return l = L(untallied(l + r)); }
+template <std::integral L, typename R> requires is_tallied<R>
+constexpr L& operator-=(L& l, R r) { return l = L(untallied(l - r)); }
+template <std::integral L, typename R> requires is_tallied<R>
+constexpr L& operator|=(L& l, R r) { return l = L(untallied(l | r)); }
+
+template <typename T> constexpr auto operator-(TalliedInt<T> x) { return tallied<Counter::add>(-x.value); }
+template <typename T> constexpr auto operator~(TalliedInt<T> x) { return tallied<Counter::add>(~x.value); }
+
+template <typename L, typename R> // the usual arithmetic conversions, made explicit
+using TalliedCommon = std::common_type_t<decltype(untallied(L())), decltype(untallied(R()))>;
+
+template <typename C>
+constexpr bool tallied_compare(bool result) { // a comparison is a compare and a branch
+    tally<C>(Counter::add);
+    tally<int>(Counter::branch);
+    return result;
+}
+
+template <typename L, typename R> requires TalliedOperands<L, R>
+constexpr bool operator==(L l, R r) {
+    using C = TalliedCommon<L, R>;
+    return tallied_compare<C>(C(untallied(l)) == C(untallied(r)));
+}
+
+template <typename L, typename R> requires TalliedOperands<L, R>
+constexpr bool operator!=(L l, R r) {
+    using C = TalliedCommon<L, R>;
+    return tallied_compare<C>(C(untallied(l)) != C(untallied(r)));
+}
+
+template <typename L, typename R> requires TalliedOperands<L, R>
+constexpr bool operator<(L l, R r) {
+    using C = TalliedCommon<L, R>;
+    return tallied_compare<C>(C(untallied(l)) < C(untallied(r)));
+}
+
+template <typename L, typename R> requires TalliedOperands<L, R>
+constexpr bool operator<=(L l, R r) {
+    using C = TalliedCommon<L, R>;
+    return tallied_compare<C>(C(untallied(l)) <= C(untallied(r)));
+}
+
+template <typename L, typename R> requires TalliedOperands<L, R>
+constexpr bool operator>(L l, R r) {
+    using C = TalliedCommon<L, R>;
+    return tallied_compare<C>(C(untallied(l)) > C(untallied(r)));
+}
+
+template <typename L, typename R> requires TalliedOperands<L, R>
+constexpr bool operator>=(L l, R r) {
+    using C = TalliedCommon<L, R>;
+    return tallied_compare<C>(C(untallied(l)) >= C(untallied(r)));
+}
+
+
+template <std::unsigned_integral T>
+constexpr TalliedInt<int> tinyfloat_clz(TalliedInt<T> x) {
+    tally<T>(Counter::clz);
+    return std::countl_zero(x.value);
+}
+
+template <typename T> using Tallied = TalliedInt<T>;
+
+#define TINYFLOAT_SCOPE(op) StatsScope tinyfloat_scope(Counted::op)
+#define TINYFLOAT_COUNT(op, counter, n) \
+    (std::is_constant_evaluated() ? void() : tinyfloat_count_quietly(Counted::op, Counter::counter, [&] { return uint64_t(n); }))
+#define TINYFLOAT_TALLY(counter, n) (std::is_constant_evaluated() ? void() : tinyfloat_tally(Counter::counter, uint64_t(n)))
+#else
+template <typename T> using Tallied = T;
+
+#define TINYFLOAT_SCOPE(op) ((void)0)
+#define TINYFLOAT_COUNT(op, counter, n) ((void)0)
+#define TINYFLOAT_TALLY(counter, n) ((void)0)
+#endif
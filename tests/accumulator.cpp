@@ -0,0 +1,127 @@
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include "accumulator.h"
+#include <catch2/catch_test_macros.hpp>
+
+static uint32_t bits(const TinyFloat& f) {
+    return f.bits();
+}
+
+TEST_CASE("exact sums") {
+    const float max = std::numeric_limits<float>::max(), inf = std::numeric_limits<float>::infinity();
+    std::vector<TinyFloat> v;
+    CHECK(bits(exact_sum(v)) == bits(TinyFloat(0.0f)));                       // empty
+    v = { -0.0f, -0.0f };
+    CHECK(bits(exact_sum(v)) == bits(TinyFloat(-0.0f)));
+    v = { -0.0f, 0.0f, -0.0f };
+    CHECK(bits(exact_sum(v)) == bits(TinyFloat(0.0f)));
+    v = { -1.5f, 1.5f };
+    CHECK(bits(exact_sum(v)) == bits(TinyFloat(0.0f)));                       // x + -x is +0
+    v = { 1e38f, 1, -1e38f };
+    CHECK(bits(exact_sum(v)) == bits(TinyFloat(1)));
+    v = { max, max, -max };                    // no overflow in between
+    CHECK(bits(exact_sum(v)) == bits(TinyFloat(max)));
+    v = { max, max };
+    CHECK(bits(exact_sum(v)) == bits(TinyFloat(inf)));
+    v = { -max, -max };
+    CHECK(bits(exact_sum(v)) == bits(TinyFloat(-inf)));
+    v = { 1, 0x1p-24f, 0x1p-149f };            // above the tie
+    CHECK(bits(exact_sum(v)) == bits(TinyFloat(1 + 0x1p-23f)));
+    v = { 1, 0x1p-24f };                       // a tie, to even
+    CHECK(bits(exact_sum(v)) == bits(TinyFloat(1)));
+    v = { inf, 1, -inf };
+    CHECK(exact_sum(v).isnan());
+    v = { inf, max, max };
+    CHECK(bits(exact_sum(v)) == bits(TinyFloat(inf)));
+    v = { -0x1p-149f, 0x1p-148f, -0x1p-126f };
+    CHECK(bits(exact_sum(v)) == bits(TinyFloat(-0x1p-126f + 0x1p-149f)));
+
+    std::mt19937 gen(0);
+    for (int n=0; n<1000; n++) {               // close exponents, the sum is exact in double
+        std::vector<TinyFloat> a;
+        double sum = 0;
+        for (int i=0; i<200; i++) {
+            float x = std::ldexp(float(int32_t(gen()) >> 8), int(gen() % 20) - 10 - 4 * (n % 30));
+            a.push_back(x);
+            sum += x;
+        }
+        INFO(sum);
+        CHECK(bits(exact_sum(a)) == bits(TinyFloat(float(sum))));
+    }
+}
+
+TEST_CASE("exact dot products") {
+    const float max = std::numeric_limits<float>::max(), inf = std::numeric_limits<float>::infinity();
+    std::vector<TinyFloat> a = { max, max, -max }, b = { 2, 2, 3 };
+    CHECK(bits(exact_dot(a, b)) == bits(TinyFloat(max)));
+    a = { 0x1p-75f, 0x1p-149f };               // 2^-150 + 2^-298 is above the tie
+    b = { 0x1p-75f, 0x1p-149f };
+    CHECK(bits(exact_dot(a, b)) == bits(TinyFloat(0x1p-149f)));
+    a = { 0x1p-75f };
+    b = { -0x1p-75f };
+    CHECK(bits(exact_dot(a, b)) == bits(TinyFloat(-0.0f)));                   // underflows to -0
+    a = { 0.0f, 1 };
+    b = { inf, 1 };
+    CHECK(exact_dot(a, b).isnan());
+    a = { -0.0f, 0.0f };
+    b = { 1, -1 };
+    CHECK(bits(exact_dot(a, b)) == bits(TinyFloat(-0.0f)));
+    a = { 1 + 0x1p-23f, -1 };                  // (1 + 2^-23)^2 - 1 needs the product unrounded
+    b = { 1 + 0x1p-23f, 1 };
+    CHECK(bits(exact_dot(a, b)) == bits(TinyFloat(0x1p-22f + 0x1p-46f)));
+
+    std::mt19937 gen(1);
+    for (int n=0; n<1000; n++) {               // 12-bit mantissas, the products and their sum are exact in double
+        std::vector<TinyFloat> x, y;
+        double sum = 0;
+        for (int i=0; i<50; i++) {
+            float p = std::ldexp(float(int32_t(gen()) >> 20), int(gen() % 8) - 4 * (n % 40));
+            float q = std::ldexp(float(int32_t(gen()) >> 20), int(gen() % 8) - 10);
+            x.push_back(p);
+            y.push_back(q);
+            sum += double(p) * q;
+        }
+        INFO(sum);
+        CHECK(bits(exact_dot(x, y)) == bits(TinyFloat(float(sum))));
+    }
+}
+
+TEST_CASE("merged accumulators are reproducible") {
+    std::mt19937 gen(2);
+    std::vector<TinyFloat> a;
+    for (int i=0; i<20000; i++) {              // all the exponents, with cancellation
+        uint32_t u = gen() & 0xfeffffff;       // no nan or inf
+        a.push_back(TinyFloat::from_bits(u));
+        a.push_back(-TinyFloat::from_bits(u ^ (gen() % 16)));
+    }
+    TinyFloat reference = exact_sum(a);
+    for (int split=0; split<20; split++) {
+        std::shuffle(a.begin(), a.end(), gen);
+        Accumulator total;
+        for (size_t begin=0; begin<a.size(); ) {
+            size_t end = std::min(a.size(), begin + 1 + gen() % 5000);
+            Accumulator part;
+            for (size_t i=begin; i<end; i++)
+                part.add(a[i]);
+            total.merge(part);
+            begin = end;
+        }
+        CHECK(bits(total.result()) == bits(reference));
+    }
+
+    Accumulator products, squares;             // sum of (x+y)^2 - x^2 - y^2 - 2xy is exactly 0
+    for (int i=0; i<1000; i++) {
+        TinyFloat x = TinyFloat(float(int32_t(gen()) >> 20)), y = TinyFloat(float(int32_t(gen()) >> 20));
+        TinyFloat s = x + y;
+        products.add_product(s, s);
+        squares.add_product(-x, x);
+        squares.add_product(-y, y);
+        squares.add_product(TinyFloat(-2) * x, y);
+    }
+    products.merge(squares);
+    CHECK(bits(products.result()) == bits(TinyFloat(0.0f)));
+}
+
@@ -86,7 +86,6 @@ TEST_CASE("multiplication") {
 TEST_CASE("division") {
     for (float a : values) {
         for (float b : values) {
-          if (b==0 || std::isinf(b)) continue;
             TinyFloat sa(a);
             TinyFloat sb(b);
             float ref = a / b;
@@ -117,3 +116,14 @@ TEST_CASE("negation") {
     }
 }
 
+
+TEST_CASE("rounding of a wide mantissa") {
+    CHECK(round_to_tinyfloat(false, 0, 1).bits() == 0x3f800000);                     // 1, exact
+    CHECK(round_to_tinyfloat(false, -47, 0x1000001ull << 23).bits() == 0x3f800000);  // 1 + 2^-24 ties to even
+    CHECK(round_to_tinyfloat(false, -47, 0x1000003ull << 23).bits() == 0x3f800002);  // 1 + 3*2^-24 ties to even
+    CHECK(round_to_tinyfloat(false, -213, 0xC000000000000000).bits() == 0x00000001); // 0.75 of the least subnormal
+    CHECK(round_to_tinyfloat(true,  -213, 0x8000000000000000).bits() == 0x80000000); // half of it ties to -0
+    CHECK(round_to_tinyfloat(false, -214, 0xC000000000000000).bits() == 0x00000000); // below the half
+    CHECK(round_to_tinyfloat(false, -212, 0xC000000000000000).bits() == 0x00000002); // 1.5 ties to even
+    CHECK(round_to_tinyfloat(false, 128, 1).isinf());                                // overflow
+}
@@ -0,0 +1,66 @@
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <limits>
+#include <random>
+#include "batch.h"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+TEST_CASE("batch operations") {
+    float special[] = {
+        0.0f,
+        -0.0f,
+        1.0f,
+        -1.0f,
+        1.5f,
+        std::nextafterf(1.0f, 0.0f), // just below 1.0
+        std::nextafterf(1.0f, 2.0f), // just above 1.0
+        std::ldexp(1.0f, -126),      // smallest normal
+        std::ldexp(1.0f, -149),      // smallest subnormal
+        std::ldexp(1.0f, -64),       // product underflows
+        1e30f,                       // large finite
+        std::numeric_limits<float>::max(),
+        std::numeric_limits<float>::infinity(),
+        -std::numeric_limits<float>::infinity(),
+        std::numeric_limits<float>::quiet_NaN()
+    };
+
+    std::vector<TinyFloat> a, b;
+    for (float x : special)          // all pairs of special values
+        for (float y : special) {
+            a.push_back(x);
+            b.push_back(y);
+        }
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<uint32_t> bits;
+    for (int i=0; i<10000; i++) {    // random bit patterns and close exponents
+        uint32_t u = bits(gen), v = bits(gen);
+        if (i % 2) v = (v & 0x80FFFFFF) | (u & 0x7F000000);
+        a.push_back(TinyFloat::from_bits(u));
+        b.push_back(TinyFloat::from_bits(v));
+    }
+
+    size_t n = a.size();
+    PackedVector pa = pack(a), pb = pack(b), pout(n);
+    std::vector<TinyFloat> out(n);
+
+    auto check = [&](auto op, const char* name) {
+        INFO(name);
+        for (size_t i=0; i<n; i++) {
+            uint32_t ref = op(a[i], b[i]).bits();
+            CHECK(out[i].bits() == ref);
+            CHECK(pout[i].bits == ref);
+        }
+    };
+
+    add(a, b, out); add(pa, pb, pout); check([](TinyFloat x, TinyFloat y) { return x + y; }, "add");
+    sub(a, b, out); sub(pa, pb, pout); check([](TinyFloat x, TinyFloat y) { return x - y; }, "sub");
+    mul(a, b, out); mul(pa, pb, pout); check([](TinyFloat x, TinyFloat y) { return x * y; }, "mul");
+    div(a, b, out); div(pa, pb, pout); check([](TinyFloat x, TinyFloat y) { return x / y; }, "div");
+    neg(a, out);    neg(pa, pout);     check([](TinyFloat x, TinyFloat)   { return -x;    }, "neg");
+
+    mul(pa, pb, pa);                 // in-place
+    for (size_t i=0; i<n; i++)
+        CHECK(pa[i].bits == (a[i] * b[i]).bits());
+}
+
@@ -0,0 +1,53 @@
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <limits>
+#include "tinyfloat.h"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+constexpr TinyFloat one   = 1;
+constexpr TinyFloat two   = one + one;
+constexpr TinyFloat three = two + one;
+constexpr TinyFloat third = one / three;
+constexpr TinyFloat tenth = TinyFloat(1) / TinyFloat(10);
+constexpr TinyFloat coefficients[] = { one, -one/two, one/three, -one/(two*two) }; // folded at compile time
+
+static_assert(two == TinyFloat(2));
+static_assert(three * three - one == TinyFloat(8));
+static_assert(one < two && two <= two && three > two && three >= two && one != two);
+static_assert(TinyFloat(0.1f) == tenth);
+static_assert(float(third) == 1.f/3.f);
+static_assert(float(coefficients[3]) == -.25f);
+static_assert((TinyFloat::inf() - TinyFloat::inf()).isnan());
+static_assert(TinyFloat::from_bits(TinyFloat(1.5f).bits()) == TinyFloat(1.5f));
+
+constexpr float values[] = { 1.f, -3.f, .1f, std::numeric_limits<float>::denorm_min(), std::numeric_limits<float>::max() };
+constexpr int n = sizeof(values) / sizeof(values[0]);
+
+struct Table { TinyFloat product[n][n], quotient[n][n]; };
+
+constexpr Table folded_table() {
+    Table t = {};
+    for (int i=0; i<n; i++)
+        for (int j=0; j<n; j++) {
+            t.product[i][j]  = TinyFloat(values[i]) * TinyFloat(values[j]);
+            t.quotient[i][j] = TinyFloat(values[i]) / TinyFloat(values[j]);
+        }
+    return t;
+}
+
+TEST_CASE("constant expressions") {
+    constexpr Table folded = folded_table();
+    volatile int size = n;     // keeps the runtime operations out of constant folding
+    for (int i=0; i<size; i++)
+        for (int j=0; j<size; j++) { // runtime results are the same as the compile-time ones, and as the host float ones
+            TinyFloat a = values[i], b = values[j];
+            CHECK((a * b).bits() == folded.product[i][j].bits());
+            CHECK((a / b).bits() == folded.quotient[i][j].bits());
+            CHECK(float(a * b) == values[i] * values[j]);
+            CHECK(float(a / b) == values[i] / values[j]);
+        }
+    constexpr TinyFloat sum = coefficients[0] + coefficients[1] + coefficients[2] + coefficients[3];
+    CHECK(float(sum) == 1.f - .5f + 1.f/3.f - .25f);
+}
+
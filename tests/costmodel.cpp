@@ -0,0 +1,60 @@
+#include <limits>
+#include <sstream>
+#include "costmodel.h"
+#include "tinyfloat.h"
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("integer cost model") {
+    CHECK(estimated_cycles(IntegerOps{ 1, 2, 3, 4, 5, 6 }, { "unit", 1, 1, 1, 1, 1, 1 }) == 21);
+
+    TinyFloatStats none;
+    CHECK(estimated_cycles(integer_ops(none), rv32imc) == 0);
+
+#ifdef TINYFLOAT_STATS
+    volatile float one = 1.f, three = 3.f, big = 1e10f, tiny = 1e-40f, inf = std::numeric_limits<float>::infinity();
+    TinyFloat a = one, b = three, c = big, d = tiny, e = inf;
+    auto cost = [](auto&& operation) {
+        reset_tinyfloat_stats();
+        operation();
+        return estimated_cycles(integer_ops(tinyfloat_stats()), cortex_m3);
+    };
+
+    double special   = cost([&] { (void)(a * e); });
+    double normal    = cost([&] { (void)(a * b); });
+    double subnormal = cost([&] { (void)(d * c); }); // the result is normal, the normalization loop runs
+    CHECK(0 < special);
+    CHECK(special < normal);
+    CHECK(normal < subnormal);
+
+    reset_tinyfloat_stats();
+    (void)(a / b);
+    (void)(b / c);
+    OperatorStats div = tinyfloat_stats()[Counted::div];
+    CHECK(div.ops.div == div.iterations);      // one division per quotient digit
+    CHECK(div.ops.mul == div.iterations);      // and a multiply-subtract for the remainder
+    CHECK(estimated_cycles(div.ops, cortex_m0plus) > estimated_cycles(div.ops, cortex_m3)); // no hardware divider
+
+    reset_tinyfloat_stats();
+    (void)(a * b);
+    (void)(a * e);
+    OperatorStats mul = tinyfloat_stats()[Counted::mul];
+    CHECK(mul.ops.mul == 4 * (mul.calls - mul.special)); // 24x24 bits as four 12x12-bit products
+    CHECK(mul.ops.div == 0);
+
+    reset_tinyfloat_stats();
+    (void)sqrt(b);                             // the test for negative numbers is a comparison
+    (void)(a + b);
+    (void)to_integer<int>(c);
+    TinyFloatStats s = tinyfloat_stats();
+    CHECK(s[Counted::sqrt].ops.mul + s[Counted::sqrt].ops.div == 0);
+    CHECK(s[Counted::compare].calls == 1);
+    CHECK(s[Counted::compare].ops.branch > 0);
+    CHECK(s[Counted::convert].calls == 1);
+    CHECK(s[Counted::convert].ops.shift > 0);
+    CHECK(s[Counted::add].ops.clz == 1);       // a single normalization shift
+#endif
+
+    std::ostringstream out;
+    print_cost_estimate(out, tinyfloat_stats(), cortex_m3);
+    CHECK(out.str().find("cortex-m3") != std::string::npos);
+}
@@ -0,0 +1,60 @@
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <limits>
+#include <random>
+#include "batch.h"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+static_assert(!std::is_convertible_v<TinyFloat, TinyFloatDivisor>); // the precomputation must be visible at the call site
+
+TEST_CASE("precomputed divisor") {
+    float values[] = {
+        0.0f,
+        -0.0f,
+        1.0f,
+        -1.0f,
+        3.0f,
+        0.1f,
+        std::nextafterf(1.0f, 0.0f), // just below 1.0
+        std::nextafterf(1.0f, 2.0f), // just above 1.0
+        std::ldexp(1.0f, -126),      // smallest normal
+        std::ldexp(1.0f, -149),      // smallest subnormal
+        std::ldexp(5.0f, -140),      // subnormal
+        1e30f,                       // large finite
+        std::numeric_limits<float>::max(),
+        std::numeric_limits<float>::infinity(),
+        -std::numeric_limits<float>::infinity(),
+        std::numeric_limits<float>::quiet_NaN()
+    };
+
+    std::vector<TinyFloat> numerators;
+    for (float f : values)
+        numerators.push_back(f);
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<uint32_t> bits;
+    for (int i=0; i<2000; i++)
+        numerators.push_back(TinyFloat::from_bits(bits(gen)));
+
+    std::vector<TinyFloat> divisors = numerators;
+    divisors.resize(200);
+
+    std::vector<TinyFloat> out(numerators.size());
+    PackedVector packed = pack(numerators), packed_out(numerators.size());
+    for (const TinyFloat& b : divisors) {
+        TinyFloatDivisor d(b);
+        div(numerators, d, out);
+        div(packed, d, packed_out);
+        for (size_t i=0; i<numerators.size(); i++) {
+            TinyFloat ref = numerators[i] / b;
+            if (ref.isnan()) {
+                CHECK(out[i].isnan());
+                CHECK(TinyFloat(packed_out[i]).isnan());
+            } else {
+                CHECK(out[i].bits() == ref.bits());
+                CHECK(packed_out[i].bits == ref.bits());
+            }
+        }
+    }
+}
+
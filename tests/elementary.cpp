@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include "elementary.h"
+#include <catch2/catch_test_macros.hpp>
+
+static double ulp_error(const TinyFloat& got, double ref) { // the host libm in double is the reference
+    float g = got;
+    if (std::isnan(ref) || std::isnan(g))
+        return std::isnan(ref) == std::isnan(g) ? 0 : INFINITY;
+    if (std::isinf(float(ref)) || std::isinf(g))
+        return float(ref) == g ? 0 : INFINITY;
+    int e;
+    std::frexp(ref, &e);
+    double ulp = std::ldexp(1.0, std::max(e - 1, -126) - 23);
+    return std::fabs(double(g) - ref) / ulp;
+}
+
+static void same(const TinyFloat& got, float expected) {  // exact, the sign of zero included
+    INFO(float(got) << " vs " << expected);
+    if (std::isnan(expected))
+        CHECK(got.isnan());
+    else
+        CHECK(got.bits() == std::bit_cast<uint32_t>(expected));
+}
+
+TEST_CASE("exp and log") {
+    const float inf = std::numeric_limits<float>::infinity(), nan = std::numeric_limits<float>::quiet_NaN();
+    same(exp(TinyFloat(-0.0f)), 1);
+    same(exp(TinyFloat(inf)), inf);
+    same(exp(TinyFloat(-inf)), 0);
+    same(exp(TinyFloat(nan)), nan);
+    same(exp2(TinyFloat(10)), 1024);           // exact powers of 2
+    same(exp2(TinyFloat(-149)), 0x1p-149f);
+    same(exp2(TinyFloat(-150)), 0);            // a tie, to even
+    same(exp2(TinyFloat(128)), inf);
+    same(log(TinyFloat(1)), 0);
+    same(log(TinyFloat(-0.0f)), -inf);
+    same(log(TinyFloat(-1)), nan);
+    same(log(TinyFloat(inf)), inf);
+    same(log2(TinyFloat(-inf)), nan);
+    same(log2(TinyFloat(0x1p-149f)), -149);
+    same(log2(TinyFloat(0x1p127f)), 127);
+
+    double worst[4] = {};
+    for (uint64_t u = 0; u < (1ull<<32); u += 4093) {  // both signs, all the exponents
+        float a = std::bit_cast<float>(uint32_t(u));
+        TinyFloat x = a;
+        worst[0] = std::max(worst[0], ulp_error(exp(x),  std::exp(double(a))));
+        worst[1] = std::max(worst[1], ulp_error(exp2(x), std::exp2(double(a))));
+        worst[2] = std::max(worst[2], ulp_error(log(x),  std::log(double(a))));
+        worst[3] = std::max(worst[3], ulp_error(log2(x), std::log2(double(a))));
+    }
+    for (uint32_t u = 0x3f700000; u < 0x3f880000; u += 7) { // close to 1, where log is small
+        TinyFloat x = TinyFloat::from_bits(u);
+        worst[2] = std::max(worst[2], ulp_error(log(x),  std::log(double(float(x)))));
+        worst[3] = std::max(worst[3], ulp_error(log2(x), std::log2(double(float(x)))));
+    }
+    for (double w : worst)
+        CHECK(w <= 0.501);
+}
+
+TEST_CASE("sin, cos and tan") {
+    const float inf = std::numeric_limits<float>::infinity(), nan = std::numeric_limits<float>::quiet_NaN();
+    same(sin(TinyFloat(-0.0f)), -0.0f);
+    same(cos(TinyFloat(-0.0f)), 1);
+    same(tan(TinyFloat(-0.0f)), -0.0f);
+    same(sin(TinyFloat(0x1p-140f)), 0x1p-140f);
+    same(sin(TinyFloat(inf)), nan);
+    same(cos(TinyFloat(-inf)), nan);
+    same(tan(TinyFloat(nan)), nan);
+
+    double worst[3] = {};
+    auto check = [&](float a) {
+        TinyFloat x = a;
+        worst[0] = std::max(worst[0], ulp_error(sin(x), std::sin(double(a))));
+        worst[1] = std::max(worst[1], ulp_error(cos(x), std::cos(double(a))));
+        worst[2] = std::max(worst[2], ulp_error(tan(x), std::tan(double(a))));
+    };
+    for (uint64_t u = 0; u < (1ull<<32); u += 4093)
+        check(std::bit_cast<float>(uint32_t(u)));
+    float hard[] = {                               // close to multiples of pi/2, where the reduction loses most bits
+        0x1.921fb6p+0f, 0x1.921fb6p+1f, 0x1.2d97c8p+3f, 0x1.fe4b4cp+34f, 0x1.17bd30p+83f, 0x1.921fb6p+127f,
+        std::numeric_limits<float>::max(), 1e22f, 355.0f, 103993.0f
+    };
+    for (float a : hard) {
+        check(a);
+        check(-a);
+    }
+    for (double w : worst)
+        CHECK(w <= 0.501);
+}
+
+TEST_CASE("pow") {
+    float values[] = { 0.0f, -0.0f, 1, -1, 0.5f, -0.5f, 2, -2, 3, -3, 0x1p-149f, 0x1.fffffep127f, 1.5f,
+                       std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+                       std::numeric_limits<float>::quiet_NaN() };
+    for (float a : values)                         // the special cases, exact
+        for (float b : values) {
+            INFO("pow(" << a << ", " << b << ")");
+            same(pow(TinyFloat(a), TinyFloat(b)), float(std::pow(double(a), double(b))));
+        }
+    same(pow(TinyFloat(-1), TinyFloat(0x1p100f)), 1);
+    same(pow(TinyFloat(-2), TinyFloat(3)), -8);
+    same(pow(TinyFloat(10), TinyFloat(10)), 1e10f);
+
+    std::mt19937 gen(1);
+    double worst = 0;
+    for (int i=0; i<200000; i++) {
+        float a = std::bit_cast<float>(uint32_t(gen()) >> 1), b = std::ldexp(float(int32_t(gen())), -int(gen() % 40) - 20);
+        if (i % 2) a = 1 + std::ldexp(float(int32_t(gen())), -int(gen() % 40) - 31); // close to 1 with large exponents
+        worst = std::max(worst, ulp_error(pow(TinyFloat(a), TinyFloat(b)), std::pow(double(a), double(b))));
+    }
+    CHECK(worst <= 0.502);
+}
+
+TEST_CASE("atan2") {
+    float values[] = { 0.0f, -0.0f, 1, -1, 0x1p-149f, -0x1p-149f, 0x1.fffffep127f,
+                       std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+                       std::numeric_limits<float>::quiet_NaN() };
+    for (float a : values)
+        for (float b : values) {
+            INFO("atan2(" << a << ", " << b << ")");
+            same(atan2(TinyFloat(a), TinyFloat(b)), float(std::atan2(double(a), double(b))));
+        }
+
+    std::mt19937 gen(1);
+    double worst = 0;
+    for (int i=0; i<200000; i++) {
+        float a = std::bit_cast<float>(uint32_t(gen())), b = std::bit_cast<float>(uint32_t(gen()));
+        if (i % 2) b = std::ldexp(a, int(gen() % 16) - 8) * (gen() % 2 ? 1 : -1); // comparable magnitudes
+        if (std::isnan(a) || std::isnan(b)) continue;
+        worst = std::max(worst, ulp_error(atan2(TinyFloat(a), TinyFloat(b)), std::atan2(double(a), double(b))));
+    }
+    CHECK(worst <= 0.501);
+}
+
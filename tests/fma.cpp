@@ -0,0 +1,61 @@
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <limits>
+#include <random>
+#include "tinyfloat.h"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+static void check(float a, float b, float c) {
+    float ref = std::fmaf(a, b, c);
+    float got = fma(TinyFloat(a), TinyFloat(b), TinyFloat(c));
+    if (std::isnan(ref)) { // both should be NaN
+        CHECK(std::isnan(got));
+    } else if (ref == 0.0f && got == 0.0f) { // check signed zero
+        CHECK(std::signbit(ref) == std::signbit(got));
+    } else { // compare exact bits
+        CHECK(ref == got);
+    }
+}
+
+TEST_CASE("fused multiply-add") {
+    float values[] = {
+        0.0f,
+        -0.0f,
+        1.0f,
+        -1.0f,
+        0.5f,
+        3.0f,
+        1.0f/3.0f,
+        -1.0f/3.0f,
+        std::ldexp(1.0f, -24),       // 2^-24 (rounding boundary)
+        std::ldexp(1.0f, -25),       // 2^-25 (sticky case)
+        std::nextafterf(1.0f, 0.0f), // just below 1.0
+        std::nextafterf(1.0f, 2.0f), // just above 1.0
+        std::ldexp(1.0f, -126),      // smallest normal
+        std::ldexp(1.0f, -149),      // smallest subnormal
+        1e30f,                       // large finite
+        -1e30f,
+        std::numeric_limits<float>::max(),
+        -std::numeric_limits<float>::max(),
+        std::numeric_limits<float>::infinity(),
+        -std::numeric_limits<float>::infinity(),
+        std::numeric_limits<float>::quiet_NaN()
+    };
+
+    for (float a : values)
+        for (float b : values)
+            for (float c : values)
+                check(a, b, c);
+
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<uint32_t> bits;
+    for (int i=0; i<100000; i++) {
+        float a = std::bit_cast<float>(bits(gen));
+        float b = std::bit_cast<float>(bits(gen));
+        float c = a * b;  // massive cancellation, exact product error
+        if (i % 3) c = std::bit_cast<float>((std::bit_cast<uint32_t>(c) & 0xFF800000) | (bits(gen) & 0x007FFFFF)) * (i % 2 ? -1.f : 1.f);
+        check(a, b, -c);
+    }
+}
+
@@ -0,0 +1,72 @@
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <string>
+#include "format.h"
+#include <catch2/catch_test_macros.hpp>
+
+static std::string format(const TinyFloat& f, int mode, std::chars_format fmt = std::chars_format::general, int precision = 0) {
+    char buf[256];
+    auto [ptr, ec] = mode == 0 ? to_chars(buf, std::end(buf), f)
+                   : mode == 1 ? to_chars(buf, std::end(buf), f, fmt)
+                               : to_chars(buf, std::end(buf), f, fmt, precision);
+    REQUIRE(ec == std::errc());
+    return std::string(buf, ptr);
+}
+
+static void check(float x) {                   // the host to_chars is the reference
+    TinyFloat f = x;
+    char buf[256];
+    INFO(x);
+    CHECK(format(f, 0) == std::string(buf, std::to_chars(buf, std::end(buf), x).ptr));
+    for (auto fmt : {std::chars_format::fixed, std::chars_format::scientific, std::chars_format::general, std::chars_format::hex}) {
+        INFO(int(fmt));
+        CHECK(format(f, 1, fmt) == std::string(buf, std::to_chars(buf, std::end(buf), x, fmt).ptr));
+        for (int precision : {0, 1, 2, 3, 6, 9, 17, 40}) {
+            INFO(precision);
+            CHECK(format(f, 2, fmt, precision) == std::string(buf, std::to_chars(buf, std::end(buf), x, fmt, precision).ptr));
+        }
+    }
+}
+
+TEST_CASE("to_chars special cases") {
+    float values[] = {
+        0.0f, -0.0f, 1.0f, -1.5f, 0.1f, 0.5f, 0.05f, 0.25f, 2.5f, 9.5f, 99.5f, 999999.5f, 1e-5f, 1e-4f, 123456.0f,
+        1234567.0f, 1e16f, 1e17f, 12345678901234567.0f, 0x1.8p30f, 0x1.fffffep0f, 0x1.08p0f, 0x1.18p0f,
+        std::numeric_limits<float>::max(), std::numeric_limits<float>::min(), std::numeric_limits<float>::denorm_min(),
+        std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity()
+    };
+    for (float x : values)
+        check(x);
+
+    CHECK(format(TinyFloat::nan(), 0) == "nan");
+    CHECK(format(TinyFloat(-1), 2, std::chars_format::fixed, -1) == "-1.000000"); // like printf
+}
+
+TEST_CASE("to_chars random values") {
+    std::mt19937 gen(1);
+    for (int i=0; i<20000; i++) {
+        float x = std::bit_cast<float>(uint32_t(gen()));
+        if (!std::isnan(x))
+            check(x);
+    }
+}
+
+TEST_CASE("to_chars small buffers") {
+    char buf[64];
+    TinyFloat f = 1234.5f;
+    for (int size=0; size<6; size++) {        // "1234.5"
+        auto [ptr, ec] = to_chars(buf, buf + size, f);
+        CHECK(ec == std::errc::value_too_large);
+        CHECK(ptr == buf + size);
+    }
+    auto [ptr, ec] = to_chars(buf, buf + 6, f);
+    CHECK(ec == std::errc());
+    CHECK(std::string(buf, ptr) == "1234.5");
+    CHECK(to_chars(buf, buf + 20, f, std::chars_format::fixed, 20).ec == std::errc::value_too_large);
+    CHECK(to_chars(buf, buf + 9, -f, std::chars_format::scientific, 3).ec == std::errc::value_too_large);
+    auto e = to_chars(buf, buf + 10, -f, std::chars_format::scientific, 3);
+    CHECK(e.ec == std::errc());
+    CHECK(std::string(buf, e.ptr) == "-1.234e+03"); // even on ties
+}
+
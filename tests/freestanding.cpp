@@ -0,0 +1,30 @@
+#include "tinyfloat.h"
+#include "smallfloat.h"
+
+// Built with -ffreestanding -fno-exceptions -fno-rtti and linked without the C++ runtime (-nostdlib++):
+// it fails to link if the arithmetic core (or SmallFloat) pulls in iostream, exceptions or any other part of libstdc++.
+// No host float either, the values go through the IEEE 754 encoding.
+
+constexpr uint32_t one = 0x3f800000, two = 0x40000000, three = 0x40400000, third = 0x3eaaaaab, tiny = 0x00000001;
+
+static volatile uint32_t bits[] = { one, two, three, tiny }; // keeps the operations out of constant evaluation
+
+int main() {
+    TinyFloat a = TinyFloat::from_bits(bits[0]), b = TinyFloat::from_bits(bits[1]), c = TinyFloat::from_bits(bits[2]);
+    TinyFloat d = TinyFloat::from_bits(bits[3]);
+    int failures = 0;
+    failures += (a + b).bits() != three;
+    failures += (c - b).bits() != one;
+    failures += (b * b).bits() != 0x40800000;
+    failures += (a / c).bits() != third;
+    failures += fma(a, b, a).bits() != three;
+    failures += sqrt(b * b).bits() != two;
+    failures += (d * b).bits() != 2;                 // subnormal
+    failures += (d / (a / c)).bits() != 3;           // 1/3 rounds up, 3 tiny after rounding
+    failures += to_integer<int32_t>(c * c) != 9;
+    failures += TinyFloat(-7).bits() != 0xc0e00000;
+    failures += !(a < b) || a == b;
+    failures += (Binary16(a) / Binary16(c)).bits != 0x3555; // 1/3 in half precision
+    return failures;
+}
+
@@ -0,0 +1,74 @@
+#include <random>
+#include <vector>
+#include "linalg.h"
+#include "accumulator.h"
+#include <catch2/catch_test_macros.hpp>
+
+static PackedVector random_matrix(std::mt19937& gen, size_t size) {
+    PackedVector v(size);
+    for (PackedFloat& x : v) {
+        uint32_t u = gen();
+        uint32_t r = gen() % 1024;
+        if (r == 0)  u |= 0x7f800000;                        // inf or nan, rare enough to leave most sums finite
+        else if (r < 64)  u &= 0x807fffff;                   // subnormal or zero
+        else if (r < 128) u &= 0x80000000;                   // zero
+        else u = (u & 0x83ffffff) | 0x3c000000;              // exponents close to 0, the sums do not overflow
+        x.bits = u;
+    }
+    return v;
+}
+
+static TinyFloat naive(const PackedFloat* a, size_t a_stride, const PackedFloat* b, size_t b_stride, int k, Accumulation mode) {
+    if (mode == Accumulation::exact) {
+        Accumulator acc;
+        for (int p=0; p<k; p++)
+            acc.add_product(a[p * a_stride], b[p * b_stride]);
+        return acc.result();
+    }
+    TinyFloat sum = 0;
+    for (int p=0; p<k; p++)
+        sum = mode == Accumulation::fused ? fma(a[p * a_stride], b[p * b_stride], sum)
+                                          : sum + TinyFloat(a[p * a_stride]) * TinyFloat(b[p * b_stride]);
+    return sum;
+}
+
+static bool same(const PackedFloat& x, const TinyFloat& y) {
+    return TinyFloat(x).isnan() ? y.isnan() : x.bits == y.bits();
+}
+
+TEST_CASE("dot, gemv and gemm are bit-identical to the naive loops") {
+    std::mt19937 gen(0);
+    struct { int m, n, k; } sizes[] = { {3, 3, 3}, {4, 4, 4}, {1, 1, 0}, {5, 7, 1}, {70, 260, 130}, {9, 300, 20}, {130, 5, 300} };
+    for (Accumulation mode : { Accumulation::rounded, Accumulation::fused, Accumulation::exact })
+        for (auto [m, n, k] : sizes) {
+            INFO("mode " << int(mode) << ", " << m << "x" << k << " times " << k << "x" << n);
+            PackedVector a = random_matrix(gen, size_t(m) * k), b = random_matrix(gen, size_t(k) * n), c(size_t(m) * n);
+            gemm(m, n, k, a, b, c, mode);
+            int errors = 0;
+            for (int i=0; i<m; i++)
+                for (int j=0; j<n; j++)
+                    errors += !same(c[size_t(i) * n + j], naive(&a[size_t(i) * k], 1, &b[j], n, k, mode));
+            CHECK(errors == 0);
+
+            PackedVector x(b.begin(), b.begin() + k), y(m);
+            gemv(m, k, a, x, y, mode);
+            errors = 0;
+            for (int i=0; i<m; i++)
+                errors += !same(y[i], naive(&a[size_t(i) * k], 1, x.data(), 1, k, mode));
+            CHECK(errors == 0);
+
+            PackedVector row(a.begin(), a.begin() + k);
+            CHECK(same(PackedFloat(dot(row, x, mode)), naive(row.data(), 1, x.data(), 1, k, mode)));
+        }
+
+    std::vector<TinyFloat> big(1000), small(1000);  // a long dot product, crossing the internal blocks
+    for (size_t i=0; i<big.size(); i++) {
+        big[i] = TinyFloat(float(int32_t(gen()))) / TinyFloat(3);
+        small[i] = TinyFloat(float(int32_t(gen()) >> 8)) / TinyFloat(7);
+    }
+    PackedVector a = pack(big), b = pack(small);
+    for (Accumulation mode : { Accumulation::rounded, Accumulation::fused, Accumulation::exact })
+        CHECK(same(PackedFloat(dot(a, b, mode)), naive(a.data(), 1, b.data(), 1, int(a.size()), mode)));
+    CHECK(dot(a, b, Accumulation::exact) == exact_dot(big, small));
+}
+
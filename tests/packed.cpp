@@ -0,0 +1,49 @@
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <limits>
+#include <bit>
+#include "packed.h"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+TEST_CASE("packed storage") {
+    float values[] = {
+        0.0f,
+        -0.0f,
+        1.0f,
+        -1.0f,
+        0.5f,
+        std::nextafterf(1.0f, 0.0f), // just below 1.0
+        std::ldexp(1.0f, -126),      // smallest normal
+        std::ldexp(1.0f, -149),      // smallest subnormal
+        -std::ldexp(3.0f, -140),     // subnormal
+        std::numeric_limits<float>::max(),
+        std::numeric_limits<float>::infinity(),
+        -std::numeric_limits<float>::infinity(),
+        std::numeric_limits<float>::quiet_NaN()
+    };
+
+    std::vector<TinyFloat> unpacked;
+    for (float f : values) {
+        TinyFloat t(f);
+        PackedFloat p(t);
+        CHECK(p.bits == std::bit_cast<uint32_t>(f)); // same layout as the host float
+        TinyFloat back = p;
+        CHECK(back.negative == t.negative);
+        CHECK(back.exponent == t.exponent);
+        CHECK(back.mantissa == t.mantissa);
+        unpacked.push_back(t);
+    }
+
+    PackedVector packed = pack(unpacked);
+    CHECK(packed.size() == unpacked.size());
+    packed[2] = packed[2] + packed[2];                // arithmetic directly on the container elements
+    CHECK(float(TinyFloat(packed[2])) == 2.0f);
+
+    std::vector<TinyFloat> back = unpack(packed);
+    for (size_t i=0; i<back.size(); i++) {
+        float ref = i==2 ? 2.0f : values[i];
+        CHECK(std::bit_cast<uint32_t>(float(back[i])) == std::bit_cast<uint32_t>(ref));
+    }
+}
+
@@ -2,6 +2,8 @@
 #include <cstring>
 #include <cmath>
 #include "tinyfloat.h"
+#include "printer.h"
+#include "costmodel.h"
 
 // PARANOIA tests the floating point arithmetic implementation on a computer.
 // PARANOIA was originally written in BASIC (!) by Professor William Kahan.
@@ -54,20 +56,21 @@ void TstCond(Level level, bool valid, std::string msg) {
 
 int main() {
     //  First two assignments use integer right-hand sides.
-    const FLOAT Zero = 0;
-    const FLOAT One = 1;
-    const FLOAT Two = One + One;
-    const FLOAT Three = Two + One;
-    const FLOAT Four = Three + One;
-    const FLOAT Five = Four + One;
-    const FLOAT Eight = Four + Four;
-    const FLOAT Nine = Three * Three;
-    const FLOAT TwentySeven = Nine * Three;
-    const FLOAT ThirtyTwo = Four * Eight;
-    const FLOAT TwoForty = Four * Five * Three * Four;
-    const FLOAT MinusOne = -One;
-    const FLOAT Half = One / Two;
-    const FLOAT OneAndHalf = One + Half;
+    //  These constants are folded at compile time.
+    constexpr FLOAT Zero = 0;
+    constexpr FLOAT One = 1;
+    constexpr FLOAT Two = One + One;
+    constexpr FLOAT Three = Two + One;
+    constexpr FLOAT Four = Three + One;
+    constexpr FLOAT Five = Four + One;
+    constexpr FLOAT Eight = Four + Four;
+    constexpr FLOAT Nine = Three * Three;
+    constexpr FLOAT TwentySeven = Nine * Three;
+    constexpr FLOAT ThirtyTwo = Four * Eight;
+    constexpr FLOAT TwoForty = Four * Five * Three * Four;
+    constexpr FLOAT MinusOne = -One;
+    constexpr FLOAT Half = One / Two;
+    constexpr FLOAT OneAndHalf = One + Half;
 
     std::cout << "Program is now RUNNING tests on small integers:\n";
 
@@ -632,6 +635,11 @@ int main() {
             "lack(s) of guard digits or failure(s) to correctly round or chop\n\
             (noted above) count as one flaw in the final tally below");
 
+#ifdef TINYFLOAT_STATS
+    std::cout << '\n' << tinyfloat_stats();   // what the run would cost on a target without an FPU
+    for (const CostTable* target : { &cortex_m0plus, &cortex_m3, &rv32imc })
+        print_cost_estimate(std::cout << '\n', tinyfloat_stats(), *target);
+#endif
     return 0;
 }
 
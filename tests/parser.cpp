@@ -0,0 +1,75 @@
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include "parser.h"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+static void check(const char* s, std::chars_format fmt = std::chars_format::general) { // the host from_chars is the reference
+    float ref = 0;
+    TinyFloat got(12345);
+    auto [ref_ptr, ref_ec] = std::from_chars(s, s + std::strlen(s), ref, fmt);
+    auto [ptr, ec] = from_chars(s, s + std::strlen(s), got, fmt);
+    INFO(s);
+    CHECK(ptr == ref_ptr);
+    CHECK(ec == ref_ec);
+    if (ec == std::errc() && std::isnan(ref))
+        CHECK(got.isnan());
+    else if (ec == std::errc())
+        CHECK(got.bits() == std::bit_cast<uint32_t>(ref));
+    else                                   // left unmodified
+        CHECK(got == TinyFloat(12345));
+}
+
+TEST_CASE("parsing special cases") {
+    const char* values[] = {
+        "0", "-0", "1.5", "1e10", ".5", "5.", "00000.000001", "inf", "-Infinity", "nan", "nan(123)", "nan(",
+        "", ".", "-", "1e", "1e+", " 1", "+1",
+        "3.4028235e38", "3.4028236e38", "1e39", "1e400", "0e400", "1e-400", "1e-46", "1e-45", "7e-46", "7.1e-46",
+        "1.401298464324817e-45",
+        "0.000000000000000000000000000000000000000000000700649232162408535461864791644958065640130970938257885878534141944895541342930300743319094181060791015625",
+        "0.000000000000000000000000000000000000000000000700649232162408535461864791644958065640130970938257885878534141944895541342930300743319094181060791015625001",
+        "16777217", "33554435", "16777217.000000000000000000000000001", "16777216.99999999999999999999999",
+        "1.00000005960464477539062500", "1.000000059604644775390625000000000000000000000000000000000001",
+        "1.0000000596046447753906249999999999999999",
+        "340282356779733661637539395458142568448", "340282356779733661637539395458142568447",
+        "123456789012345678901234567890e-20"
+    };
+    for (const char* s : values)
+        for (auto fmt : {std::chars_format::general, std::chars_format::fixed, std::chars_format::scientific})
+            check(s, fmt);
+
+    const char* hex[] = {
+        "1p0", "1.8p3", "-1.8P-3", "0.000001p0", "ffffffp0", "1ffffffp0", "1.fffffep127", "1.ffffffp127",
+        "1p-149", "1p-150", "1.000001p-150", "0x1p3", "abcdef0123456789abcp-40", "1.000001000000000000000001p0",
+        "1.000003p0", "1.000002fffffffffffffffffffp0", "p3", ".p3", "1p", "1p+"
+    };
+    for (const char* s : hex)
+        check(s, std::chars_format::hex);
+}
+
+TEST_CASE("parsing random values") {
+    std::mt19937 gen(1);
+    char buf[256];
+    for (int i=0; i<100000; i++) {
+        float f = std::bit_cast<float>(uint32_t(gen()));
+        if (std::isnan(f)) continue;
+        std::snprintf(buf, sizeof(buf), "%.*g", int(gen() % 12 + 1), f);
+        check(buf);
+        std::snprintf(buf, sizeof(buf), "%.9g", f); // shortest roundtrip length
+        check(buf);
+        std::snprintf(buf, sizeof(buf), "%a", f);
+        std::string s = buf;
+        s.erase(s.find("0x"), 2);
+        check(s.c_str(), std::chars_format::hex);
+
+        double halfway = (double(f) + double(std::nextafter(f, std::numeric_limits<float>::infinity()))) / 2;
+        std::snprintf(buf, sizeof(buf), "%.40g", halfway);  // needs the big integer comparison
+        check(buf);
+        std::snprintf(buf, sizeof(buf), "%.120g", halfway); // exact
+        check(buf);
+    }
+}
+
@@ -2,6 +2,13 @@
 #include <cmath>
 #include <limits>
 #include "tinyfloat.h"
+#include "parser.h"
+#include "shortest.h"
+#include "printer.h"
+#include <random>
+#include <charconv>
+#include <algorithm>
+#include <sstream>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_template_test_macros.hpp>
 
@@ -32,9 +39,14 @@ nan\n\
     for (float f : values) {
         std::ostringstream o;
         o << TinyFloat(f);
-        std::istringstream i(o.str());
-        float v = std::stof(o.str());
+        std::string s = o.str();
+        float v = std::stof(s);                // the host parser is the reference
         CHECK( ((std::isnan(v) && std::isnan(f)) ||  v == f) );
+        TinyFloat t;
+        auto [ptr, ec] = from_chars(s.data(), s.data() + s.size(), t);
+        CHECK(ec == std::errc());
+        CHECK(ptr == s.data() + s.size());
+        CHECK( ((t.isnan() && std::isnan(f)) || t.bits() == TinyFloat(f).bits()) );
     }
 
     std::ostringstream o;
@@ -43,3 +55,104 @@ nan\n\
     CHECK(o.str() == expected);
 }
 
+TEST_CASE("shortest printing") {
+    std::string expected("0.0\n\
+-0.0\n\
+1.5\n\
+0.1\n\
+100.0\n\
+1234.5\n\
+0.0001\n\
+1e-05\n\
+16777216.0\n\
+1e+16\n\
+1.2345678e+16\n\
+1e-45\n\
+-1.1754944e-38\n\
+3.4028235e+38\n\
+inf\n\
+nan\n\
+");
+
+    float values[] = {
+        0.0f,
+        -0.0f,
+        1.5f,
+        0.1f,
+        100.0f,
+        1234.5f,
+        0.0001f,
+        0.00001f,
+        16777216.0f,
+        1e16f,
+        12345678901234567.0f,
+        std::numeric_limits<float>::denorm_min(),
+        -std::numeric_limits<float>::min(),
+        std::numeric_limits<float>::max(),
+        std::numeric_limits<float>::infinity(),
+        std::numeric_limits<float>::quiet_NaN()
+    };
+
+    std::ostringstream o;
+    o << shortest;
+    for (float f : values)
+        o << TinyFloat(f) << "\n";
+    CHECK(o.str() == expected);
+
+    o.str("");
+    o << exact << TinyFloat(0.1f);             // the mode sticks until changed
+    CHECK(o.str() == "0.100000001490116119384765625");
+
+    std::mt19937 gen(1);
+    for (int i=0; i<100000; i++) {             // shortest roundtrip
+        TinyFloat f = TinyFloat::from_bits(uint32_t(gen()));
+        if (!f.isfinite()) continue;
+        std::ostringstream s;
+        s << shortest << f;
+        std::string str = s.str();
+        TinyFloat v;
+        from_chars(str.data(), str.data() + str.size(), v);
+        CHECK(v.bits() == f.bits());
+
+        char buf[64];                          // same digits as the host shortest to_chars
+        auto [ptr, ec] = std::to_chars(buf, buf + sizeof(buf), float(f), std::chars_format::scientific);
+        std::string digits(buf + f.negative, std::find(buf, ptr, 'e'));
+        std::erase(digits, '.');
+        while (digits.size() > 1 && digits.back() == '0') digits.pop_back();
+        CHECK(std::to_string(shortest_decimal(f).significand) == digits);
+    }
+}
+
+TEST_CASE("digits on demand") {                // a prefix of the exact expansion, then a sticky digit
+    std::mt19937_64 gen(1);
+    for (int i=0; i<200000; i++) {
+        uint64_t mantissa = gen() >> (gen() % 64);
+        int exponent = int(gen() % 2100) - 1074;
+        ExactDecimal exact(mantissa, exponent);
+        DecimalDigits d(mantissa, exponent);
+        INFO(mantissa << " * 2^" << exponent);
+        int top = exact.size - 1 - exact.point;
+        if (exact.size)
+            REQUIRE(d.top == top);
+        int lowest = top - int(gen() % 40) + 2;
+        d.generate(lowest);
+
+        auto digit = [](const char* digits, int size, int q, int power) {
+            return power >= q && power < q + size ? digits[size - 1 - (power - q)] : '0';
+        };
+        bool rest = false;
+        for (int power = lowest - 1; power >= -exact.point; power--)
+            rest |= digit(exact.digits, exact.size, -exact.point, power) != '0';
+        if (top < lowest || !exact.size)
+            CHECK(d.size == 0);
+        else {
+            for (int power = top; power >= lowest; power--)
+                CHECK(digit(d.digits, d.size, d.q, power) == digit(exact.digits, exact.size, -exact.point, power));
+            CHECK((d.q == lowest - 1) == rest);
+            if (rest)
+                CHECK(d.digits[d.size-1] == '1');
+            CHECK(d.q >= lowest - 1);
+        }
+    }
+}
+
@@ -1,13 +1,57 @@
 #define _USE_MATH_DEFINES
 #include <cmath>
 #include <limits>
+#include <random>
 #include "tinyfloat.h"
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_template_test_macros.hpp>
 
 TEST_CASE("int cast roundtrip") {
-    int values[] = {0, 1, -1, 42, -999999, 1<<23, -(1<<23)};
+    int values[] = {0, 1, -1, 42, -999999, 1<<23, -(1<<23), 1<<24, -(1<<24), std::numeric_limits<int>::min()};
     for (int x : values)
         CHECK(x == int(TinyFloat(x)));
 }
 
+TEMPLATE_TEST_CASE("integer to float rounding", "", int32_t, uint32_t, int64_t, uint64_t) {
+    std::mt19937_64 gen(1);
+    TestType values[] = {0, 1, 16777217, 16777219, 33554435, std::numeric_limits<TestType>::min(), std::numeric_limits<TestType>::max()};
+    for (TestType x : values)
+        CHECK(float(TinyFloat(x)) == float(x));
+    for (int i=0; i<100000; i++) {
+        TestType x = TestType(gen() >> (gen() % 64)); // all magnitudes
+        CHECK(float(TinyFloat(x)) == float(x));       // the host conversion is correctly rounded
+    }
+}
+
+TEMPLATE_TEST_CASE("float to integer", "", int32_t, uint32_t, int64_t, uint64_t) {
+    std::mt19937 gen(2);
+    for (int i=0; i<100000; i++) {
+        float f = std::ldexp(float(int32_t(gen())), int(gen() % 90) - 60); // magnitudes from 2^-60 to 2^60
+        TinyFloat t(f);
+        double lo = double(std::numeric_limits<TestType>::min()), hi = double(std::numeric_limits<TestType>::max());
+        auto saturate = [&](double x) { return x < lo ? std::numeric_limits<TestType>::min() : x >= hi ? std::numeric_limits<TestType>::max() : TestType(x); };
+        CHECK(to_integer<TestType>(t) == saturate(std::trunc(f)));
+        CHECK(to_integer<TestType>(t, RoundingMode::floor) == saturate(std::floor(f)));
+        CHECK(to_integer<TestType>(t, RoundingMode::nearest) == saturate(std::nearbyint(f)));
+        CHECK(TestType(t) == to_integer<TestType>(t));
+    }
+}
+
+TEST_CASE("float to integer, special cases") {
+    CHECK(to_integer<int>(TinyFloat(2.5f), RoundingMode::nearest) == 2);
+    CHECK(to_integer<int>(TinyFloat(3.5f), RoundingMode::nearest) == 4);
+    CHECK(to_integer<int>(TinyFloat(-2.5f), RoundingMode::nearest) == -2);
+    CHECK(to_integer<int>(TinyFloat(-0.5f), RoundingMode::floor) == -1);
+    CHECK(to_integer<int>(TinyFloat(-0.5f)) == 0);
+    CHECK(to_integer<int>(TinyFloat(std::numeric_limits<float>::denorm_min()), RoundingMode::nearest) == 0);
+    CHECK(to_integer<int>(-TinyFloat(std::numeric_limits<float>::denorm_min()), RoundingMode::floor) == -1);
+    CHECK(to_integer<int>(TinyFloat(3e9f)) == std::numeric_limits<int>::max());
+    CHECK(to_integer<int>(TinyFloat(-3e9f)) == std::numeric_limits<int>::min());
+    CHECK(to_integer<int>(TinyFloat(-2147483648.f)) == std::numeric_limits<int>::min());
+    CHECK(to_integer<uint32_t>(TinyFloat(-1.f)) == 0);
+    CHECK(to_integer<uint64_t>(TinyFloat(std::numeric_limits<float>::max())) == std::numeric_limits<uint64_t>::max());
+    CHECK(to_integer<int64_t>(TinyFloat::inf(true)) == std::numeric_limits<int64_t>::min());
+    CHECK(to_integer<int64_t>(TinyFloat::nan()) == 0);
+    CHECK(to_integer<int64_t>(TinyFloat(9007199254740993ll)) == 9007199254740992ll);
+}
+
@@ -0,0 +1,83 @@
+#define _USE_MATH_DEFINES
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include "smallfloat.h"
+#include "printer.h"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+template <int ebits, int mbits>
+double reference(double x, SmallFloat<ebits, mbits>) { // rounds x to the narrow format, binary64 is wide enough to avoid double rounding
+    if (std::isnan(x) || std::isinf(x) || x == 0) return x;
+    int e = std::max(std::ilogb(x), SmallFloat<ebits, mbits>::emin);
+    double r = std::ldexp(std::nearbyint(std::ldexp(x, mbits - e)), e - mbits); // ties to even
+    if (std::fabs(r) >= std::ldexp(1.0, SmallFloat<ebits, mbits>::emax + 1))
+        return std::copysign(std::numeric_limits<double>::infinity(), r);
+    return r;
+}
+
+template <typename T>
+void check(double ref, T got) {
+    double g = float(TinyFloat(got));
+    ref = reference(ref, T{});
+    if (std::isnan(ref)) { // both should be NaN
+        CHECK(std::isnan(g));
+    } else {               // compare values and signs of zero
+        CHECK(ref == g);
+        CHECK(std::signbit(ref) == std::signbit(g));
+    }
+}
+
+template <typename T>
+void check_pair(T a, T b) {
+    double x = float(TinyFloat(a)), y = float(TinyFloat(b));
+    check(x + y, a + b);
+    check(x - y, a - b);
+    check(x * y, a * b);
+    check(x / y, a / b);
+}
+
+TEMPLATE_TEST_CASE("8-bit formats, exhaustive", "", FP8E5M2, FP8E4M3IEEE) {
+    for (int u=0; u<256; u++) {
+        TestType a = TestType::from_bits(u);
+        if (!TinyFloat(a).isnan())               // round trip through TinyFloat, nan payloads are not kept
+            CHECK(TestType(TinyFloat(a)).bits == u);
+        check(std::sqrt(double(float(TinyFloat(a)))), sqrt(a));
+        check(-double(float(TinyFloat(a))), -a);
+        for (int v=0; v<256; v++)
+            check_pair(a, TestType::from_bits(v));
+    }
+}
+
+TEMPLATE_TEST_CASE("16-bit formats", "", Binary16, BFloat16) {
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<uint16_t> bits;
+    for (int i=0; i<65536; i++) {
+        TestType a = TestType::from_bits(i);
+        if (!TinyFloat(a).isnan())
+            CHECK(TestType(TinyFloat(a)).bits == i);
+        check(std::sqrt(double(float(TinyFloat(a)))), sqrt(a));
+        TestType b = TestType::from_bits(bits(gen));
+        check_pair(a, b);
+    }
+    for (float f : { 1.f/3.f, 65504.f, 65520.f, 1e-8f, 3e-5f, 1e38f, std::ldexp(1.f, -130), std::ldexp(3.f, -140) }) // rounding from binary32
+        check(f, TestType(f));
+
+    CHECK(sizeof(TestType) == 2);
+}
+
+TEST_CASE("binary16 values") {
+    CHECK(Binary16(TinyFloat(1)).bits == 0x3C00);
+    CHECK(Binary16(TinyFloat(65504)).bits == 0x7BFF);         // largest finite
+    CHECK(Binary16(TinyFloat(65520)).bits == 0x7C00);         // rounds to inf
+    CHECK(Binary16(TinyFloat(std::ldexp(1.f, -24))).bits == 0x0001); // smallest subnormal
+    CHECK(BFloat16(TinyFloat(1.f/3.f)).bits == 0x3EAB);
+    CHECK(FP8E4M3IEEE(TinyFloat(240)).bits == 0x77);
+    CHECK(FP8E5M2(TinyFloat(-57344)).bits == 0xFB);
+    std::ostringstream o;
+    o << Binary16(TinyFloat(0.1f));
+    CHECK(o.str() == "0.0999755859375");
+}
+
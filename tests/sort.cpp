@@ -0,0 +1,111 @@
+#include <cmath>
+#include <limits>
+#include <random>
+#include <algorithm>
+#include "sort.h"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+static float ordered[] = {       // ascending in the total order
+    -std::numeric_limits<float>::quiet_NaN(),
+    -std::numeric_limits<float>::infinity(),
+    -std::numeric_limits<float>::max(),
+    -1.0f,
+    -std::numeric_limits<float>::min(),
+    -std::numeric_limits<float>::denorm_min(),
+    -0.0f,
+    0.0f,
+    std::numeric_limits<float>::denorm_min(),
+    std::numeric_limits<float>::min(),
+    std::nextafterf(1.0f, 0.0f),
+    1.0f,
+    std::nextafterf(1.0f, 2.0f),
+    std::numeric_limits<float>::max(),
+    std::numeric_limits<float>::infinity(),
+    std::numeric_limits<float>::quiet_NaN()
+};
+
+static std::vector<TinyFloat> random_values(size_t n, uint32_t seed) {
+    std::mt19937 gen(seed);
+    std::vector<TinyFloat> values(n);
+    for (TinyFloat& f : values)
+        f = TinyFloat::from_bits(gen());
+    return values;
+}
+
+static bool less_bits(const TinyFloat& a, const TinyFloat& b) { // reference order
+    float x = a, y = b;
+    if (std::signbit(x) != std::signbit(y)) return std::signbit(x);
+    if (std::isnan(x) || std::isnan(y))     // compare payloads
+        return std::signbit(x) ? a.bits() > b.bits() : a.bits() < b.bits();
+    if (x == y) return std::signbit(x) && !std::signbit(y);
+    return x < y;
+}
+
+TEST_CASE("sort key") {
+    for (size_t i=0; i+1<std::size(ordered); i++)
+        CHECK(sort_key(TinyFloat(ordered[i])) < sort_key(TinyFloat(ordered[i+1])));
+
+    std::vector<TinyFloat> values = random_values(100000, 1);
+    for (size_t i=0; i+1<values.size(); i++) {
+        CHECK((sort_key(values[i]) < sort_key(values[i+1])) == less_bits(values[i], values[i+1]));
+        CHECK(TinyFloat(from_sort_key(sort_key(values[i]))).bits() == values[i].bits());
+        if (!values[i].isnan() && !values[i+1].isnan() && values[i] != values[i+1])
+            CHECK((sort_key(values[i]) < sort_key(values[i+1])) == (values[i] < values[i+1]));
+    }
+}
+
+TEST_CASE("radix sort") {
+    for (size_t n : {0, 1, 100, 255, 256, 1000, 100000}) {
+        std::vector<TinyFloat> values = random_values(n, uint32_t(n));
+        std::vector<TinyFloat> reference = values;
+        std::stable_sort(reference.begin(), reference.end(), less_bits);
+        sort(values);
+        for (size_t i=0; i<n; i++)
+            CHECK(values[i].bits() == reference[i].bits());
+
+        PackedVector packed = pack(reference);
+        std::shuffle(packed.begin(), packed.end(), std::mt19937(2));
+        sort(packed);
+        for (size_t i=0; i<n; i++)
+            CHECK(packed[i].bits == reference[i].bits());
+    }
+
+    std::vector<TinyFloat> values(1000, TinyFloat(1));    // one digit is the same everywhere
+    for (size_t i=0; i<values.size(); i+=3)
+        values[i] = -TinyFloat(int(i));
+    std::vector<TinyFloat> reference = values;
+    std::stable_sort(reference.begin(), reference.end(), less_bits);
+    sort(values);
+    for (size_t i=0; i<values.size(); i++)
+        CHECK(values[i].bits() == reference[i].bits());
+}
+
+TEST_CASE("min, max and clamp") {
+    std::vector<TinyFloat> values = random_values(10000, 3);
+    std::vector<TinyFloat> finite;
+    for (const TinyFloat& f : values)
+        if (!f.isnan())
+            finite.push_back(f);
+
+    CHECK(float(min(std::span<const TinyFloat>(finite))) == float(*std::min_element(finite.begin(), finite.end(), less_bits)));
+    CHECK(float(max(std::span<const TinyFloat>(finite))) == float(*std::max_element(finite.begin(), finite.end(), less_bits)));
+    CHECK(min(std::span<const TinyFloat>(values)).bits() == std::min_element(values.begin(), values.end(), less_bits)->bits());
+    CHECK(max(std::span<const TinyFloat>(values)).bits() == std::max_element(values.begin(), values.end(), less_bits)->bits());
+
+    PackedVector packed = pack(values);
+    CHECK(min(std::span<const PackedFloat>(packed)).bits == min(std::span<const TinyFloat>(values)).bits());
+    CHECK(max(std::span<const PackedFloat>(packed)).bits == max(std::span<const TinyFloat>(values)).bits());
+
+    TinyFloat lo = -1, hi = 2;
+    std::vector<TinyFloat> out(finite.size());
+    clamp(finite, lo, hi, out);
+    for (size_t i=0; i<finite.size(); i++)
+        CHECK(float(out[i]) == std::clamp(float(finite[i]), -1.f, 2.f));
+
+    PackedVector packed_out(packed.size());
+    clamp(packed, lo, hi, packed_out);
+    for (size_t i=0; i<packed.size(); i++)
+        CHECK(float(TinyFloat(packed_out[i])) == (values[i].isnan() ? (values[i].negative ? -1.f : 2.f) : std::clamp(float(values[i]), -1.f, 2.f)));
+}
+
@@ -0,0 +1,45 @@
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <limits>
+#include "tinyfloat.h"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+TEST_CASE("square root") {
+    float values[] = {
+        0.0f,
+        -0.0f,
+        1.0f,
+        -1.0f,
+        2.0f,
+        4.0f,
+        0.5f,
+        std::nextafterf(1.0f, 0.0f), // just below 1.0
+        std::nextafterf(1.0f, 2.0f), // just above 1.0
+        std::ldexp(1.0f, -126),      // smallest normal
+        std::ldexp(1.0f, -149),      // smallest subnormal
+        std::ldexp(3.0f, -140),      // subnormal
+        std::numeric_limits<float>::max(),
+        std::numeric_limits<float>::infinity(),
+        -std::numeric_limits<float>::infinity(),
+        std::numeric_limits<float>::quiet_NaN()
+    };
+
+    for (float a : values) {
+        float ref = std::sqrt(a);
+        float got = sqrt(TinyFloat(a));
+        if (std::isnan(ref)) { // both should be NaN
+            CHECK(std::isnan(got));
+        } else { // compare exact bits, including the sign of zero
+            CHECK(std::bit_cast<uint32_t>(ref) == std::bit_cast<uint32_t>(got));
+        }
+    }
+
+    int mismatches = 0;
+    for (uint32_t u = 0; u < 0x7F800000u; u += 61) { // a sweep over all positive finite floats
+        float a = std::bit_cast<float>(u);
+        mismatches += std::bit_cast<uint32_t>(std::sqrt(a)) != sqrt(TinyFloat(a)).bits();
+    }
+    CHECK(mismatches == 0);
+}
+
@@ -0,0 +1,51 @@
+#include <sstream>
+#include <thread>
+#include "tinyfloat.h"
+#include "printer.h"
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("operator statistics") {
+    reset_tinyfloat_stats();
+    volatile float one = 1.f, three = 3.f, tiny = 1e-40f;
+    TinyFloat a = one, b = three, c = tiny;
+    TinyFloat r = a / b;                       // rounded
+    r = r + a;
+    r = r * c;                                 // subnormal
+    r = sqrt(b);
+    r = fma(a, b, TinyFloat(std::numeric_limits<float>::infinity())); // special
+    (void)r;
+    std::thread([&] { (void)(a * b); }).join(); // the counts of a finished thread are kept
+    constexpr TinyFloat folded = TinyFloat(1.f) + TinyFloat(2.f); // constant evaluation is not counted
+    (void)folded;
+
+    TinyFloatStats s = tinyfloat_stats();
+#ifdef TINYFLOAT_STATS
+    CHECK(s[Counted::add].calls == 1);
+    CHECK(s[Counted::mul].calls == 2);
+    CHECK(s[Counted::mul].subnormal == 1);
+    CHECK(s[Counted::mul].iterations > 0);
+    CHECK(s[Counted::div].calls == 1);
+    CHECK(s[Counted::div].iterations == 3);
+    CHECK(s[Counted::div].rounding == 1);
+    CHECK(s[Counted::fma].special == 1);
+    CHECK(s[Counted::sqrt].iterations == 24);
+
+    reset_tinyfloat_stats();
+    s = tinyfloat_stats();
+    CHECK(s[Counted::mul].calls == 0);
+
+    r = fma(TinyFloat(0), b, a);               // a zero product is handed over to operator+
+    s = tinyfloat_stats();
+    CHECK(s[Counted::fma].calls == 1);
+    CHECK(s[Counted::fma].special == 0);
+    CHECK(s[Counted::add].calls == 1);
+#else
+    for (int op=0; op<int(Counted::count); op++)
+        CHECK(s.op[op].calls == 0);
+#endif
+
+    std::ostringstream out;
+    out << s;
+    CHECK(out.str().find("sqrt") != std::string::npos);
+}
+
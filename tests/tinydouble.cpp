@@ -0,0 +1,145 @@
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <limits>
+#include <random>
+#include <sstream>
+#include "tinydouble.h"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+static double double_values[] = {
+    0.0,
+    -0.0,
+    1.0,
+    -1.0,
+    0.5,
+    -0.5,
+    2.0,
+    -2.0,
+    0.1,
+    1.0/3.0,
+    std::ldexp(1.0, -53),        // 2^-53 (rounding boundary)
+    std::ldexp(1.0, -54),        // 2^-54 (sticky case)
+    std::nextafter(1.0, 0.0),    // just below 1.0
+    std::nextafter(1.0, 2.0),    // just above 1.0
+    std::ldexp(1.0, -1022),      // smallest normal
+    std::ldexp(1.0, -1074),      // smallest subnormal
+    std::ldexp(3.0, -1060),      // subnormal
+    1e300,                       // large finite
+    -1e300,
+    std::numeric_limits<double>::max(),
+    -std::numeric_limits<double>::max(),
+    std::numeric_limits<double>::infinity(),
+    -std::numeric_limits<double>::infinity(),
+    std::numeric_limits<double>::quiet_NaN()
+};
+
+static_assert(TinyDouble(1.5) * TinyDouble(3) / TinyDouble(0.5) - TinyDouble(1) == TinyDouble(8));
+static_assert(TinyFloat(TinyDouble(0.1)) == TinyFloat(0.1f));
+static_assert(double(sqrt(TinyDouble(2.0))) == 1.4142135623730951);
+
+static void check(double ref, double got) {
+    if (std::isnan(ref)) {       // both should be NaN
+        CHECK(std::isnan(got));
+    } else {                     // compare values and signs of zero
+        CHECK(ref == got);
+        CHECK(std::signbit(ref) == std::signbit(got));
+    }
+}
+
+TEST_CASE("double arithmetic") {
+    for (double a : double_values) {
+        for (double b : double_values) {
+            TinyDouble sa(a);
+            TinyDouble sb(b);
+            check(a + b, sa + sb);
+            check(a - b, sa - sb);
+            check(a * b, sa * sb);
+            check(a / b, sa / sb);
+        }
+        check(-a, -TinyDouble(a));
+        check(std::sqrt(a), sqrt(TinyDouble(a)));
+    }
+}
+
+TEST_CASE("double arithmetic, random operands") {
+    std::mt19937_64 gen(1);
+    for (int i=0; i<1000000; i++) {
+        double a = std::bit_cast<double>(gen());
+        double b = std::bit_cast<double>(gen());
+        if (i % 2)               // close exponents exercise cancellation and rounding
+            b = std::ldexp(b, std::ilogb(a) - std::ilogb(b));
+        TinyDouble sa(a);
+        TinyDouble sb(b);
+        check(a + b, sa + sb);
+        check(a - b, sa - sb);
+        check(a * b, sa * sb);
+        check(a / b, sa / sb);
+        check(std::sqrt(std::fabs(a)), sqrt(TinyDouble(std::fabs(a))));
+    }
+}
+
+TEST_CASE("double comparisons") {
+    for (double a : double_values) {
+        for (double b : double_values) {
+            TinyDouble sa(a);
+            TinyDouble sb(b);
+            CHECK((a == b) == (sa == sb));
+            CHECK((a != b) == (sa != sb));
+            CHECK((a <  b) == (sa <  sb));
+            CHECK((a >  b) == (sa >  sb));
+            CHECK((a <= b) == (sa <= sb));
+            CHECK((a >= b) == (sa >= sb));
+        }
+    }
+}
+
+TEST_CASE("double conversions") {
+    for (double a : double_values) {
+        check(a, TinyDouble(a));
+        if (!std::isnan(a))
+            CHECK(TinyDouble(a).bits() == std::bit_cast<uint64_t>(a));
+        check(float(a), float(TinyFloat(TinyDouble(a))));
+        check(float(a), double(TinyDouble(TinyFloat(float(a)))));
+    }
+
+    std::mt19937_64 gen(2);
+    for (int i=0; i<1000000; i++) {
+        double a = std::ldexp(std::bit_cast<double>(gen() >> 12 | 0x3ff0000000000000ull), int(gen() % 320) - 180);
+        check(float(a), float(TinyFloat(TinyDouble(a))));  // double rounding is not allowed, subnormals included
+    }
+
+    for (int i : {0, 1, -1, 42, -1000000, std::numeric_limits<int>::max(), std::numeric_limits<int>::min()}) {
+        check(double(i), TinyDouble(i));
+        CHECK(int(TinyDouble(i)) == i);
+    }
+    for (int64_t i : {int64_t(9007199254740993), int64_t(-9007199254740995), std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::min()})
+        check(double(i), TinyDouble(i));  // the host conversion is correctly rounded
+    check(double(std::numeric_limits<uint64_t>::max()), TinyDouble(std::numeric_limits<uint64_t>::max()));
+    CHECK(to_integer<int64_t>(TinyDouble(-2.5), RoundingMode::nearest) == -2);
+    CHECK(to_integer<int64_t>(TinyDouble(-2.5), RoundingMode::floor) == -3);
+    CHECK(to_integer<int64_t>(TinyDouble(1e19)) == std::numeric_limits<int64_t>::max());
+    CHECK(to_integer<uint64_t>(TinyDouble(1e19)) == 10000000000000000000ull);
+}
+
+TEST_CASE("double printing") {
+    auto print = [](double d) {
+        std::ostringstream out;
+        out << TinyDouble(d);
+        return out.str();
+    };
+    CHECK(print(0.0) == "0.0");
+    CHECK(print(-0.0) == "-0.0");
+    CHECK(print(1.5) == "1.5");
+    CHECK(print(-1024.0) == "-1024.0");
+    CHECK(print(0.1) == "0.1000000000000000055511151231257827021181583404541015625");
+    CHECK(print(std::numeric_limits<double>::max()) == "179769313486231570814527423731704356798070567525844996598917476803157260780028538760589558632766878171540458953514382464234321326889464182768467546703537516986049910576551282076245490090389328944075868508455133942304583236903222948165808559332123348274797826204144723168738177180919299881250404026184124858368.0");
+    std::string denorm_min = print(std::numeric_limits<double>::denorm_min());
+    CHECK(denorm_min.size() == 1076);
+    CHECK(denorm_min.starts_with("0.000000"));
+    CHECK(denorm_min.ends_with("702637090279242767544565229087538682506419718265533447265625"));
+    CHECK(print(std::numeric_limits<double>::infinity()) == "inf");
+    CHECK(print(-std::numeric_limits<double>::infinity()) == "-inf");
+    CHECK(print(std::numeric_limits<double>::quiet_NaN()) == "nan");
+}
+
@@ -0,0 +1,310 @@
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <cmath>
+#include <chrono>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include "tinyfloat.h"
+
+// Differential verification against the host float: every unary operation is checked on all 2^32 inputs,
+// the binary ones on stratified random pairs with a bias for the edge cases (exponent gaps, cancellation,
+// subnormals, overflow, special values). The work is split into chunks spread over all the cores with
+// work stealing; the operands only depend on their index, so a mismatch is reproducible with any thread count.
+//
+//   verify [--pairs N] [--threads N] [name...]    # all the checks by default, 2^30 random pairs per binary operation
+//
+// The host must have IEEE 754 binary32 arithmetic, round-to-nearest, without flush-to-zero.
+
+static bool same(const TinyFloat& got, float ref) {        // bit-exact, any nan matches any nan
+    return std::isnan(ref) ? got.isnan() : got.bits() == std::bit_cast<uint32_t>(ref);
+}
+
+template <typename T>
+static T saturate(float x) {                               // to_integer semantics: nan is 0, out of range saturates
+    constexpr float hi = std::numeric_limits<T>::max(), lo = std::numeric_limits<T>::min(); // hi rounds up to 2^(bits-1)
+    if (std::isnan(x)) return 0;
+    if (x >= hi) return std::numeric_limits<T>::max();
+    if (x <= lo) return std::numeric_limits<T>::min();
+    return T(x);
+}
+
+static uint64_t hash(uint64_t x) {                         // splitmix64, the random operands depend on the index only
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+static uint32_t make(uint32_t sign, uint32_t exponent, uint32_t mantissa) { // exponent field, clamped to [0, 255]
+    return sign << 31 | std::min(exponent, 255u) << 23 | (mantissa & 0x7fffff);
+}
+
+static uint32_t edge_mantissa(uint64_t h) {
+    const uint32_t values[] = { 0, 1, 2, 0x7fffff, 0x7ffffe, 0x400000, 0x400001, 0x3fffff, 0x000fff, 0x7ff000 };
+    return h % 2 ? values[(h >> 1) % 10] : uint32_t(h >> 8) & ~(0xffffffffu << (h >> 1) % 24); // or a few low bits
+}
+
+static uint32_t edge_exponent(uint64_t h) {
+    const uint32_t values[] = { 0, 0, 1, 2, 23, 24, 25, 100, 126, 127, 128, 150, 229, 230, 253, 254, 254, 255 };
+    return values[h % 18];
+}
+
+struct Operands { uint32_t a, b, c; };
+
+static Operands operands(uint64_t index) {                 // stratified by index % 8
+    uint64_t h1 = hash(index), h2 = hash(h1), h3 = hash(h2);
+    uint32_t a = uint32_t(h1), b = uint32_t(h2), c = uint32_t(h3);
+    uint32_t ea = (a >> 23) & 255, sa = a >> 31, sb = b >> 31;
+    switch (index % 8) {
+        case 0:                                            // random bits
+            break;
+        case 1:                                            // the same exponent, cancellation in a - b
+            b = make(sb, ea, a ^ uint32_t(h2 >> 40) % 64);
+            break;
+        case 2: {                                          // all the exponent gaps up to 63, both ways
+            uint32_t gap = (index / 8) % 64;
+            b = make(sb, ea > gap ? ea - gap : 0, b);
+            if (index / 8 % 128 >= 64) std::swap(a, b);
+            break;
+        }
+        case 3:                                            // subnormals
+            a &= 0x807fffff;
+            if (h3 % 2) b &= 0x807fffff;
+            break;
+        case 4:                                            // edge exponents and mantissas
+            a = make(sa, edge_exponent(h1 >> 32), edge_mantissa(h2 >> 16));
+            b = make(sb, edge_exponent(h2 >> 32), edge_mantissa(h3 >> 16));
+            break;
+        case 5: {                                          // the product or the quotient close to overflow or underflow
+            uint32_t target = h3 % 2 ? 254 + 127 : 127 - 126;
+            uint32_t eb = uint32_t(std::clamp(int(target) - int(ea) + int(h3 >> 8) % 5 - 2, 0, 254));
+            if (h3 % 4 >= 2) eb = uint32_t(std::clamp(int(ea) + 127 - int(target) + int(h3 >> 8) % 5 - 2, 0, 254));
+            a = make(sa, std::min(ea, 254u), a);
+            b = make(sb, eb, b);
+            break;
+        }
+        case 6:                                            // b close to a: quotients close to 1, differences close to 0
+            b = a ^ uint32_t(h2 % 8) ^ (h2 >> 3) % 2 << 31;
+            break;
+        case 7:                                            // special values mixed with random ones
+            if (h3 % 3 != 0) a = make(sa, 255, h1 % 4 ? 0 : a);
+            if (h3 % 3 != 1) b = make(sb, h2 % 2 ? 255 : 0, h2 % 4 < 2 ? 0 : b);
+            break;
+    }
+    if ((h3 >> 40) % 2) {                                  // fma: c close to -a*b half of the time
+        float p = std::bit_cast<float>(a) * std::bit_cast<float>(b);
+        c = std::bit_cast<uint32_t>(-p) ^ uint32_t(h3 >> 48) % 16;
+    }
+    return { a, b, c };
+}
+
+struct Mismatch {
+    uint64_t index;
+    Operands in;
+    uint64_t expected, got;
+};
+
+struct Report {
+    std::mutex lock;
+    std::atomic<uint64_t> count = 0;
+    std::atomic<uint64_t> last = ~0ull;                    // the largest index kept once there are 10 of them
+    std::vector<Mismatch> first;                           // the lowest indices, whatever thread found them
+
+    void add(const Mismatch& m) {
+        count++;
+        if (m.index >= last) return;
+        std::lock_guard<std::mutex> guard(lock);
+        first.push_back(m);
+        std::sort(first.begin(), first.end(), [](const Mismatch& x, const Mismatch& y) { return x.index < y.index; });
+        if (first.size() > 10) first.pop_back();
+        if (first.size() == 10) last = first.back().index;
+    }
+};
+
+struct Check {
+    const char* name;
+    bool exhaustive;                                       // all 2^32 values, or the random pairs
+    int arity;                                             // for the report
+    void (*run)(uint64_t begin, uint64_t end, Report& report);
+};
+
+template <typename Op>                                     // op(in, expected, got) returns true on success
+static void sweep(uint64_t begin, uint64_t end, Report& report, bool exhaustive, Op op) {
+    for (uint64_t i=begin; i<end; i++) {
+        Operands in = exhaustive ? Operands{ uint32_t(i), 0, 0 } : operands(i);
+        uint64_t expected = 0, got = 0;
+        if (!op(in, expected, got))
+            report.add({ i, in, expected, got });
+    }
+}
+
+#define UNARY(name, expression_tiny, expression_host)                                                        \
+    { name, true, 1, [](uint64_t begin, uint64_t end, Report& report) {                                     \
+        sweep(begin, end, report, true, [](const Operands& in, uint64_t& expected, uint64_t& got) {          \
+            TinyFloat x = TinyFloat::from_bits(in.a);                                                        \
+            float f = std::bit_cast<float>(in.a);                                                            \
+            (void)x; (void)f;                                                                                \
+            auto t = expression_tiny;                                                                        \
+            auto h = expression_host;                                                                        \
+            return compare(t, h, expected, got);                                                             \
+        });                                                                                                  \
+    } }
+
+#define BINARY(name, arity, expression_tiny, expression_host)                                                \
+    { name, false, arity, [](uint64_t begin, uint64_t end, Report& report) {                                \
+        sweep(begin, end, report, false, [](const Operands& in, uint64_t& expected, uint64_t& got) {         \
+            TinyFloat x = TinyFloat::from_bits(in.a), y = TinyFloat::from_bits(in.b), z = TinyFloat::from_bits(in.c); \
+            float f = std::bit_cast<float>(in.a), g = std::bit_cast<float>(in.b), h = std::bit_cast<float>(in.c); \
+            (void)x; (void)y; (void)z; (void)f; (void)g; (void)h;                                            \
+            auto t = expression_tiny;                                                                        \
+            auto r = expression_host;                                                                        \
+            return compare(t, r, expected, got);                                                             \
+        });                                                                                                  \
+    } }
+
+static bool compare(const TinyFloat& t, float h, uint64_t& expected, uint64_t& got) {
+    expected = std::bit_cast<uint32_t>(h);
+    got = t.bits();
+    return same(t, h);
+}
+
+template <std::integral T>
+static bool compare(T t, T h, uint64_t& expected, uint64_t& got) {
+    expected = uint64_t(h);
+    got = uint64_t(t);
+    return t == h;
+}
+
+static int64_t random_int64(const Operands& in) {          // all the bit lengths equally likely
+    uint64_t u = uint64_t(in.a) << 32 | in.b;
+    return int64_t(u) >> (in.c % 64);
+}
+
+const Check checks[] = {
+    UNARY("neg",              -x,                                                  -f),
+    UNARY("sqrt",             sqrt(x),                                             std::sqrt(f)),
+    UNARY("float round trip", TinyFloat(float(x)),                                 f),
+    UNARY("to int32",         to_integer<int32_t>(x),                              saturate<int32_t>(f)),
+    UNARY("to int32 floor",   to_integer<int32_t>(x, RoundingMode::floor),         saturate<int32_t>(std::floor(f))),
+    UNARY("to int32 nearest", to_integer<int32_t>(x, RoundingMode::nearest),       saturate<int32_t>(std::nearbyint(f))),
+    UNARY("to int64",         to_integer<int64_t>(x),                              saturate<int64_t>(f)),
+    UNARY("to uint32",        to_integer<uint32_t>(x),                             saturate<uint32_t>(f)),
+    UNARY("from int32",       TinyFloat(int32_t(in.a)),                            float(int32_t(in.a))),
+    UNARY("from uint32",      TinyFloat(in.a),                                     float(in.a)),
+    BINARY("from int64", 1,   TinyFloat(random_int64(in)),                         float(random_int64(in))),
+    BINARY("add",  2,         x + y,                                               f + g),
+    BINARY("sub",  2,         x - y,                                               f - g),
+    BINARY("mul",  2,         x * y,                                               f * g),
+    BINARY("div",  2,         x / y,                                               f / g),
+    BINARY("fma",  3,         fma(x, y, z),                                        std::fma(f, g, h)),
+    BINARY("less", 2,         int(x < y),                                          int(f < g)),
+    BINARY("less or equal", 2, int(x <= y),                                        int(f <= g)),
+    BINARY("equal", 2,        int(x == y),                                         int(f == g))
+};
+
+// Work stealing over chunk indices: every thread owns a range [begin, end) packed in one atomic word and takes
+// chunks from its front; once it runs dry, it steals the back half of the largest range left.
+// begin only grows and end only shrinks, so a compare-and-swap on the word is enough.
+struct alignas(64) Range {
+    std::atomic<uint64_t> word = 0;
+
+    static uint64_t pack(uint32_t begin, uint32_t end) { return uint64_t(begin) << 32 | end; }
+    static uint32_t size(uint64_t w) { return uint32_t(w) > uint32_t(w >> 32) ? uint32_t(w) - uint32_t(w >> 32) : 0; }
+
+    bool pop(uint32_t& chunk) {
+        uint64_t w = word.load();
+        while (size(w))
+            if (word.compare_exchange_weak(w, pack(uint32_t(w >> 32) + 1, uint32_t(w)))) {
+                chunk = uint32_t(w >> 32);
+                return true;
+            }
+        return false;
+    }
+
+    bool steal(Range& thief) {
+        uint64_t w = word.load();
+        while (size(w) >= 2) {
+            uint32_t begin = uint32_t(w >> 32), end = uint32_t(w), middle = begin + size(w) / 2;
+            if (word.compare_exchange_weak(w, pack(begin, middle))) {
+                thief.word.store(pack(middle, end));
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+template <typename Body>
+static void parallel(uint32_t chunks, int threads, Body body) {
+    std::vector<Range> ranges(threads);
+    for (int t=0; t<threads; t++)
+        ranges[t].word = Range::pack(uint32_t(uint64_t(chunks) * t / threads), uint32_t(uint64_t(chunks) * (t+1) / threads));
+    std::vector<std::thread> pool;
+    for (int t=0; t<threads; t++)
+        pool.emplace_back([&, t] {
+            for (;;) {
+                uint32_t chunk;
+                while (ranges[t].pop(chunk))
+                    body(chunk);
+                bool stolen = false;
+                while (!stolen) {
+                    int victim = -1;                       // the largest range left
+                    uint32_t largest = 1;
+                    for (int v=0; v<threads; v++)
+                        if (Range::size(ranges[v].word.load()) > largest) {
+                            largest = Range::size(ranges[v].word.load());
+                            victim = v;
+                        }
+                    if (victim < 0) break;
+                    stolen = ranges[victim].steal(ranges[t]);
+                }
+                if (!stolen) return;
+            }
+        });
+    for (std::thread& thread : pool)
+        thread.join();
+}
+
+int main(int argc, char** argv) {
+    uint64_t pairs = 1ull << 30;
+    int threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<const char*> names;
+    for (int i=1; i<argc; i++) {
+        if (!std::strcmp(argv[i], "--pairs") && i+1 < argc)
+            pairs = std::strtoull(argv[++i], nullptr, 0);
+        else if (!std::strcmp(argv[i], "--threads") && i+1 < argc)
+            threads = std::max(1, std::atoi(argv[++i]));
+        else
+            names.push_back(argv[i]);
+    }
+
+    uint64_t failed = 0;
+    for (const Check& check : checks) {
+        if (!names.empty() && std::none_of(names.begin(), names.end(), [&](const char* n) { return !std::strcmp(n, check.name); }))
+            continue;
+        uint64_t total = check.exhaustive ? 1ull << 32 : pairs;
+        constexpr uint64_t chunk = 1 << 16;
+        Report report;
+        auto start = std::chrono::steady_clock::now();
+        parallel(uint32_t((total + chunk - 1) / chunk), threads, [&](uint32_t c) {
+            check.run(c * chunk, std::min(total, (c + 1) * chunk), report);
+        });
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << std::left << std::setw(18) << check.name << std::right << std::setw(12) << total
+                  << (check.exhaustive ? " inputs " : " random ") << std::setw(10) << report.count << " mismatches  "
+                  << std::fixed << std::setprecision(1) << elapsed.count() << " s" << std::endl;
+        for (const Mismatch& m : report.first) {
+            std::cout << "    #" << std::dec << m.index << std::hex << std::setfill('0') << "  a=0x" << std::setw(8) << m.in.a;
+            if (check.arity > 1) std::cout << " b=0x" << std::setw(8) << m.in.b;
+            if (check.arity > 2) std::cout << " c=0x" << std::setw(8) << m.in.c;
+            std::cout << "  expected 0x" << m.expected << " got 0x" << m.got << std::dec << std::setfill(' ') << std::endl;
+        }
+        failed += report.count;
+    }
+    return failed ? 1 : 0;
+}
+
@@ -0,0 +1,14 @@
+#include "tinydouble.h"
+#include "printer.h"
+
+std::ostream& operator<<(std::ostream& out, const TinyDouble& f) {
+    if (f.isnan()) {
+        out << "nan";
+    } else {
+        if (f.negative) out << "-";
+        if (f.isinf())  out << "inf";
+        else print_exact(out, f.mantissa, f.exponent - 52);
+    }
+    return out;
+}
+
@@ -0,0 +1,334 @@
+#pragma once
+#include <algorithm>
+#include <iosfwd>
+#include "tinyfloat.h"
+
+struct TinyDouble {
+    bool     negative = false;
+    int16_t  exponent = -1022; // [-1022 ... 1024], corrected exponent
+    uint64_t mantissa = 0;     // [0 ... 2^53), so mantissa/2^52 is in [0, 2) range
+
+    constexpr TinyDouble(bool negative, int16_t exponent, uint64_t mantissa) : negative(negative), exponent(exponent), mantissa(mantissa) {}
+    constexpr TinyDouble() = default;
+    constexpr TinyDouble(const TinyDouble&) = default;
+    constexpr TinyDouble& operator=(const TinyDouble&) = default;
+
+    template <std::integral T> constexpr TinyDouble(T); // round-to-nearest, even-on-ties
+    constexpr TinyDouble(double);
+    constexpr TinyDouble(const TinyFloat&);          // exact
+    constexpr operator double() const;
+    explicit constexpr operator TinyFloat() const;   // round-to-nearest, even-on-ties
+    template <std::integral T> requires (!std::same_as<T, bool>)
+    explicit constexpr operator T() const;           // truncates like a C cast, see to_integer
+
+    static constexpr TinyDouble from_bits(uint64_t u); // IEEE 754 binary64 encoding, no host double involved
+    constexpr uint64_t bits() const;
+
+    constexpr bool isnan() const { return exponent == 1024 &&  mantissa; }
+    constexpr bool isinf() const { return exponent == 1024 && !mantissa; }
+    constexpr bool isfinite() const { return !isnan() && !isinf(); }
+    constexpr bool isnormal() const { return isfinite() && mantissa >= (1ull<<52); }
+
+    static constexpr TinyDouble  nan(uint64_t payload = (1ull<<53)-1) { return {false,  1024, payload}; }
+    static constexpr TinyDouble  inf(bool negative = false) { return {negative,  1024, 0}; }
+    static constexpr TinyDouble zero(bool negative = false) { return {negative, -1022, 0}; }
+
+    static constexpr TinyDouble round(bool negative, int exponent, uint64_t mantissa); // mantissa * 2^exponent, LSB may be sticky
+};
+
+std::ostream& operator<<(std::ostream& out, const TinyDouble& f);
+
+constexpr TinyDouble TinyDouble::round(bool negative, int exponent, uint64_t mantissa) {
+    if (!mantissa)
+        return zero(negative);
+
+    int e = std::max(63 - std::countl_zero(mantissa) + exponent, -1022); // exponent of the result
+    int lsb = e - 52 - exponent;             // position of the mantissa LSB
+    uint64_t m = 0;
+    bool up = false;
+    if (lsb <= 0)                            // exact
+        m = mantissa << -lsb;
+    else if (lsb < 64) {
+        m = mantissa >> lsb;
+        uint64_t remainder = mantissa % (1ull<<lsb), half = 1ull<<(lsb-1);
+        up = remainder > half || (remainder == half && m % 2); // round-to-nearest, even-on-ties
+    }
+
+    if (up && ++m == (1ull<<53)) {          // renormalize if necessary
+        m /= 2;
+        e++;
+    }
+
+    if (e >= 1024)                           // handle overflow
+        return inf(negative);
+
+    return { negative, int16_t(e), m };
+}
+
+template <std::integral T>
+constexpr TinyDouble::TinyDouble(T i) : TinyDouble(round(std::is_signed_v<T> && i < 0, 0, std::is_signed_v<T> && i < 0 ? 0 - uint64_t(i) : uint64_t(i))) {}
+
+template <std::integral T>
+constexpr T to_integer(const TinyDouble& f, RoundingMode rounding = RoundingMode::truncate) { // nan gives 0
+    if (f.isnan()) return 0;
+    if (f.isinf()) return f.negative ? std::numeric_limits<T>::min() : std::numeric_limits<T>::max();
+    return to_integer<T>(f.negative, f.mantissa, f.exponent - 52, rounding);
+}
+
+template <std::integral T> requires (!std::same_as<T, bool>)
+constexpr TinyDouble::operator T() const {
+    return to_integer<T>(*this);
+}
+
+constexpr TinyDouble::TinyDouble(double d) : TinyDouble(from_bits(std::bit_cast<uint64_t>(d))) {} // nan/inf are correctly handled
+
+constexpr TinyDouble::TinyDouble(const TinyFloat& f) {
+    if (f.isnan())
+        *this = nan();
+    else if (f.isinf())
+        *this = inf(f.negative);
+    else
+        *this = round(f.negative, f.exponent - 23, f.mantissa);
+}
+
+constexpr TinyDouble::operator double() const { // nan/inf are correctly handled
+    return std::bit_cast<double>(bits());
+}
+
+constexpr TinyDouble::operator TinyFloat() const {
+    if (isnan()) return TinyFloat::nan();
+    if (isinf()) return TinyFloat::inf(negative);
+    if (!mantissa) return TinyFloat::zero(negative);
+
+    int e = std::max(63 - std::countl_zero(mantissa) + exponent - 52, -126); // exponent of the result
+    int lsb = e - 23 - (exponent - 52);      // position of the 24-bit mantissa LSB, it is at least 29
+    uint64_t m = 0;
+    bool up = false;
+    if (lsb < 64) {
+        m = mantissa >> lsb;
+        uint64_t remainder = mantissa % (1ull<<lsb), half = 1ull<<(lsb-1);
+        up = remainder > half || (remainder == half && m % 2); // round-to-nearest, even-on-ties
+    }
+
+    if (up && ++m == (1u<<24)) {             // renormalize if necessary
+        m /= 2;
+        e++;
+    }
+
+    if (e >= 128)                            // handle overflow
+        return TinyFloat::inf(negative);
+
+    return { negative, int16_t(e), uint32_t(m) };
+}
+
+constexpr TinyDouble TinyDouble::from_bits(uint64_t u) {
+    uint64_t sign_bit     = (u >> 63) % 2;
+    uint64_t raw_exponent = (u >> 52) % 2048;
+    uint64_t raw_mantissa =  u % (1ull<<52);
+
+    TinyDouble f(sign_bit, int16_t(raw_exponent) - 1023, raw_mantissa);
+    if (f.exponent==-1023) // zero or subnormal
+        f.exponent++;
+    else if (f.exponent<1024) // normal, recover the hidden bit = 1
+        f.mantissa = raw_mantissa + (1ull<<52);
+    return f;
+}
+
+constexpr uint64_t TinyDouble::bits() const {
+    uint64_t sign_bit = negative;
+    uint64_t raw_exponent = exponent+1023;
+    uint64_t raw_mantissa = mantissa % (1ull<<52); // clear the hidden bit
+    if (exponent==-1022 && mantissa<(1ull<<52))
+        raw_exponent = 0; // zero or subnormal
+    return (sign_bit<<63) + (raw_exponent<<52) + raw_mantissa;
+}
+
+constexpr bool operator==(const TinyDouble& lhs, const TinyDouble& rhs) {
+    if (lhs.isnan() || rhs.isnan()) return false;  // NaNs are unordered
+    if (lhs.isfinite() && rhs.isfinite() && !lhs.mantissa && !rhs.mantissa) return true; // +0 = -0
+    return lhs.mantissa == rhs.mantissa && lhs.exponent == rhs.exponent && lhs.negative == rhs.negative;
+}
+
+constexpr bool operator!=(const TinyDouble& lhs, const TinyDouble& rhs) {
+    return !(lhs == rhs);
+}
+
+constexpr bool operator<(const TinyDouble& lhs, const TinyDouble& rhs) {
+    if (lhs.isnan() || rhs.isnan() || lhs==rhs) return false;
+    if (lhs.negative != rhs.negative)      // positive > negative
+        return lhs.negative;
+    return lhs.negative !=                 // same sign and not equal
+        ((lhs.exponent <  rhs.exponent) || // => check exponents and then mantissas
+         (lhs.exponent == rhs.exponent && lhs.mantissa < rhs.mantissa));
+}
+
+constexpr bool operator>(const TinyDouble& lhs, const TinyDouble& rhs) {
+    if (lhs.isnan() || rhs.isnan()) return false; // NaNs are unordered
+    return !(lhs<rhs || lhs==rhs);
+}
+
+constexpr bool operator<=(const TinyDouble& lhs, const TinyDouble& rhs) {
+    return lhs<rhs || lhs==rhs;
+}
+
+constexpr bool operator>=(const TinyDouble& lhs, const TinyDouble& rhs) {
+    return lhs>rhs || lhs==rhs;
+}
+
+constexpr TinyDouble operator+(const TinyDouble &lhs, const TinyDouble &rhs) {
+    TinyDouble a = lhs;
+    TinyDouble b = rhs;
+
+    if (a.isnan() || b.isnan())
+        return TinyDouble::nan();
+    if (a.isinf() && b.isinf()) {
+        if (a.negative == b.negative) return a; // same sign infinity
+        return TinyDouble::nan();               // inf + -inf = nan
+    }
+    if (a.isinf()) return a;
+    if (b.isinf()) return b;
+
+    if (!a.mantissa && !b.mantissa)                        // handle zeros
+        return TinyDouble::zero(a.negative && b.negative); // if signs differ, result is +0
+
+    if (a.exponent < b.exponent)
+        std::swap(a, b);
+
+    a.mantissa *= 8;                                  // reserve place for GRS bits
+    b.mantissa *= 8;
+
+    int shift = a.exponent - b.exponent;              // align exponents with a single shift
+    if (shift >= 56)                                  // b is entirely below the sticky bit
+        b.mantissa = b.mantissa != 0;
+    else if (shift > 0)                               // LSB is sticky
+        b.mantissa = (b.mantissa >> shift) | (b.mantissa % (1ull<<shift) != 0);
+
+    bool negative = a.mantissa >= b.mantissa ? a.negative : b.negative;
+    uint64_t sum = 0;
+    if (a.negative == b.negative)
+        sum = a.mantissa + b.mantissa;
+    else
+        if (a.mantissa >= b.mantissa)
+            sum = a.mantissa - b.mantissa;
+        else
+            sum = b.mantissa - a.mantissa;
+
+    if (!sum)                                         // exact cancellation gives +0
+        return TinyDouble::zero();
+    return TinyDouble::round(negative, a.exponent - 55, sum);
+}
+
+constexpr TinyDouble operator-(const TinyDouble &lhs, const TinyDouble &rhs) {
+    TinyDouble f(!rhs.negative, rhs.exponent, rhs.mantissa);
+    return lhs + f;
+}
+
+constexpr TinyDouble operator*(const TinyDouble &a, const TinyDouble &b) {
+    if (a.isnan() || b.isnan())
+        return TinyDouble::nan();
+    if (a.isinf() || b.isinf()) {
+        if ((a.isfinite() && !a.mantissa) || (b.isfinite() && !b.mantissa)) // inf * 0 = nan
+            return TinyDouble::nan();
+        return TinyDouble::inf(a.negative != b.negative);
+    }
+    if (!a.mantissa || !b.mantissa)
+        return TinyDouble::zero(a.negative != b.negative);
+
+    int a_lz = std::countl_zero(a.mantissa) - 11; // normalize subnormals
+    int b_lz = std::countl_zero(b.mantissa) - 11;
+    uint64_t a_mantissa = a.mantissa << a_lz;
+    uint64_t b_mantissa = b.mantissa << b_lz;
+
+    uint64_t a_hi = a_mantissa >> 32;            // multiply 2 53-bit mantissas
+    uint64_t a_lo = a_mantissa % (1ull<<32);     // with 32x32->64 bit multiplications
+    uint64_t b_hi = b_mantissa >> 32;            // into a 106-bit product hi*2^64 + lo
+    uint64_t b_lo = b_mantissa % (1ull<<32);
+    uint64_t middle = a_hi * b_lo + a_lo * b_hi;
+    uint64_t lo = a_lo * b_lo;
+    uint64_t hi = a_hi * b_hi + (middle >> 32) + (lo + (middle << 32) < lo);
+    lo += middle << 32;
+
+    int shift = std::countl_zero(hi) - 1;        // keep the 63 leading bits of the product, the rest is sticky
+    uint64_t mantissa = (hi << shift) | (lo >> (64 - shift)) | (lo % (1ull<<(64 - shift)) != 0);
+    int exponent = a.exponent - a_lz + b.exponent - b_lz - 104 + 64 - shift;
+    return TinyDouble::round(a.negative != b.negative, exponent, mantissa);
+}
+
+constexpr TinyDouble operator/(const TinyDouble &a, const TinyDouble &b) {
+    bool a_zero = a.isfinite() && !a.mantissa;
+    bool b_zero = b.isfinite() && !b.mantissa;
+    if (a.isnan() || b.isnan() || (a.isinf() && b.isinf()) || (a_zero && b_zero))
+        return TinyDouble::nan();
+
+    bool negative = a.negative != b.negative;
+    if (a.isinf() || b_zero)
+        return TinyDouble::inf(negative);
+
+    if (a_zero || b.isinf())
+        return TinyDouble::zero(negative);
+
+    uint64_t a_mantissa = a.mantissa, b_mantissa = b.mantissa;
+    int exponent = a.exponent - b.exponent;
+    int a_lz = std::countl_zero(a_mantissa) - 11;      // normalize subnormals
+    int b_lz = std::countl_zero(b_mantissa) - 11;
+    a_mantissa <<= a_lz;
+    b_mantissa <<= b_lz;
+    exponent += b_lz - a_lz;
+    if (a_mantissa < b_mantissa) {                     // the quotient is in [1, 2)
+        a_mantissa *= 2;
+        exponent--;
+    }
+
+    uint64_t mantissa  = 1;                            // the leading bit of the quotient
+    uint64_t remainder = a_mantissa - b_mantissa;
+    for (int i=0; i<5; i++) {                          // radix-2048 long division: 11 quotient bits per step,
+        remainder *= 2048;                             // the remainder is below 2^53, so no overflow
+        mantissa = mantissa * 2048 + remainder / b_mantissa;
+        remainder = remainder % b_mantissa;
+    }
+    mantissa = mantissa * 2 + (remainder != 0);        // 56 bits + sticky bit
+
+    return TinyDouble::round(negative, exponent - 56, mantissa);
+}
+
+constexpr TinyDouble operator-(const TinyDouble &f) {
+    if (f.isnan()) return f;
+    return { !f.negative, f.exponent, f.mantissa };
+}
+
+constexpr TinyDouble sqrt(const TinyDouble &f) { // correctly rounded, digit-by-digit
+    if (f.isnan() || f < TinyDouble::zero())   // sqrt of a negative number is nan
+        return TinyDouble::nan();
+    if (f.isinf() || !f.mantissa)              // sqrt(+inf) = +inf, sqrt(-0) = -0
+        return f;
+
+    int exponent = f.exponent;
+    uint64_t mantissa = f.mantissa;
+    int lz = std::countl_zero(mantissa) - 11;  // normalize subnormals
+    mantissa <<= lz;
+    exponent -= lz;
+    mantissa <<= exponent & 1;                 // the exponent must be even, the radicand is mantissa * 2^52
+
+    uint64_t root = 0, remainder = 0;
+    for (int i=0; i<53; i++) {                 // two radicand bits per step, the 52 trailing zeros are implicit
+        remainder = remainder * 4 + (i < 27 ? (mantissa >> (52 - 2*i)) % 4 : 0);
+        uint64_t trial = root * 4 + 1;
+        if (remainder >= trial) {
+            remainder -= trial;
+            root = root * 2 + 1;
+        } else
+            root *= 2;
+    }
+    exponent = (exponent - (exponent & 1)) / 2;
+
+    if (remainder > root) {                    // round-to-nearest, ties are impossible
+        root++;
+        if (root == (1ull<<53)) {              // renormalize if necessary
+            root /= 2;
+            exponent++;
+        }
+    }
+
+    return { false, int16_t(exponent), root };
+}
+
@@ -1,42 +1,512 @@
-#include <iostream>
+#pragma once
 #include <cstdint>
+#include <bit>
+#include <concepts>
+#include <limits>
+#include "stats.h"
+
+// The arithmetic core is header-only and freestanding: no iostream, no exceptions, no assert, no <algorithm>,
+// it builds with -ffreestanding -fno-exceptions -nostdlib++. operator<< for TinyFloat is in printer.h.
 
 struct TinyFloat {
-    bool     negative = false;
-    int16_t  exponent = -126;  // [-126 ... 128], corrected exponent
-    uint32_t mantissa = 0;     // [0 ... 2^24), so mantissa/2^23 is in [0, 2) range
-
-    TinyFloat(bool negative, int16_t exponent, uint32_t mantissa);
-    TinyFloat() = default;
-    TinyFloat(const TinyFloat&) = default;
-    TinyFloat& operator=(const TinyFloat&) = default;
-
-    TinyFloat(int);
-    TinyFloat(float);
-    operator float() const;
-
-    bool isnan() const { return exponent == 128 &&  mantissa; }
-    bool isinf() const { return exponent == 128 && !mantissa; }
-    bool isfinite() const { return !isnan() && !isinf(); }
-    bool isnormal() const { return isfinite() && mantissa >= (1u<<23); }
-
-    static TinyFloat  nan(uint32_t payload = (1u<<24)-1) { return {false,  128, payload}; }
-    static TinyFloat  inf(bool negative = false) { return {negative,  128, 0}; }
-    static TinyFloat zero(bool negative = false) { return {negative, -126, 0}; }
+    bool              negative = false;
+    Tallied<int16_t>  exponent = -126; // [-126 ... 128], corrected exponent
+    Tallied<uint32_t> mantissa = 0;    // [0 ... 2^24), so mantissa/2^23 is in [0, 2) range
+
+    constexpr TinyFloat(bool negative, int16_t exponent, uint32_t mantissa);
+    constexpr TinyFloat() = default;
+    constexpr TinyFloat(const TinyFloat&) = default;
+    constexpr TinyFloat& operator=(const TinyFloat&) = default;
+
+    template <std::integral T> constexpr TinyFloat(T);  // round-to-nearest, even-on-ties
+    constexpr TinyFloat(float);
+    constexpr operator float() const;
+    template <std::integral T> requires (!std::same_as<T, bool>)
+    explicit constexpr operator T() const;              // truncates like a C cast, see to_integer
+
+    static constexpr TinyFloat from_bits(uint32_t u); // IEEE 754 binary32 encoding, no host float involved
+    constexpr uint32_t bits() const;
+
+    constexpr bool isnan() const { return exponent == 128 &&  mantissa; }
+    constexpr bool isinf() const { return exponent == 128 && !mantissa; }
+    constexpr bool isfinite() const { return !isnan() && !isinf(); }
+    constexpr bool isnormal() const { return isfinite() && mantissa >= (1u<<23); }
+
+    static constexpr TinyFloat  nan(uint32_t payload = (1u<<24)-1) { return {false,  128, payload}; }
+    static constexpr TinyFloat  inf(bool negative = false) { return {negative,  128, 0}; }
+    static constexpr TinyFloat zero(bool negative = false) { return {negative, -126, 0}; }
 };
 
-std::ostream& operator<<(std::ostream& out, const TinyFloat& f);
+constexpr TinyFloat::TinyFloat(bool negative, int16_t exponent, uint32_t mantissa) : negative(negative), exponent(exponent), mantissa(mantissa) {}
+
+template <std::integral T>
+constexpr TinyFloat::TinyFloat(T i) {
+    TINYFLOAT_SCOPE(convert);
+    negative = std::is_signed_v<T> && Tallied<T>(i) < 0;
+    Tallied<uint64_t> magnitude = negative ? 0 - Tallied<uint64_t>(i) : Tallied<uint64_t>(i);
+    if (!magnitude) {
+        *this = TinyFloat::zero();
+        return;
+    }
+
+    exponent = 63 - tinyfloat_clz(magnitude);    // normalize in constant time
+    if (exponent <= 23) {                        // exact
+        mantissa = uint32_t(magnitude << (23 - exponent));
+        return;
+    }
+
+    Tallied<int> shift = exponent - 23;
+    Tallied<uint64_t> remainder = magnitude & ((1ull<<shift) - 1), half = 1ull<<(shift-1);
+    mantissa = uint32_t(magnitude >> shift);
+    if (remainder > half || (remainder == half && mantissa % 2)) { // round-to-nearest, even-on-ties
+        mantissa++;
+        if (mantissa == (1u<<24)) {              // renormalize if necessary, no overflow below 2^64
+            mantissa /= 2;
+            exponent++;
+        }
+    }
+}
+
+constexpr TinyFloat::TinyFloat(float f) : TinyFloat(from_bits(std::bit_cast<uint32_t>(f))) {} // nan/inf are correctly handled
+
+constexpr TinyFloat::operator float() const { // nan/inf are correctly handled
+    return std::bit_cast<float>(bits());
+}
+
+enum class RoundingMode { truncate, floor, nearest }; // nearest is even-on-ties
+
+// mantissa * 2^exponent to an integer type in constant time, out of range values saturate
+template <std::integral T>
+constexpr T to_integer(bool negative, Tallied<uint64_t> mantissa, Tallied<int> exponent, RoundingMode rounding) {
+    Tallied<uint64_t> magnitude = 0;
+    if (exponent >= 0)                           // no fractional part
+        magnitude = exponent > tinyfloat_clz(mantissa) ? Tallied<uint64_t>(~0ull) : mantissa << exponent;
+    else {
+        Tallied<int> shift = -exponent < 63 ? -exponent : Tallied<int>(63); // the mantissa is below 2^62, so it is still all fraction
+        Tallied<uint64_t> remainder = mantissa & ((1ull<<shift) - 1), half = 1ull<<(shift-1);
+        magnitude = mantissa >> shift;
+        if (rounding == RoundingMode::floor)
+            magnitude += negative && remainder;
+        if (rounding == RoundingMode::nearest)
+            magnitude += remainder > half || (remainder == half && magnitude % 2);
+    }
+
+    constexpr T lo = std::numeric_limits<T>::min(), hi = std::numeric_limits<T>::max();
+    if (negative)                                // 0 - lo is 2^(bits-1) for signed types, 0 for unsigned ones
+        return magnitude >= 0 - uint64_t(lo) ? lo : T(0 - magnitude);
+    return magnitude >= uint64_t(hi) ? hi : T(magnitude);
+}
+
+template <std::integral T>
+constexpr T to_integer(const TinyFloat& f, RoundingMode rounding = RoundingMode::truncate) { // nan gives 0
+    TINYFLOAT_SCOPE(convert);
+    if (f.isnan()) return 0;
+    if (f.isinf()) return f.negative ? std::numeric_limits<T>::min() : std::numeric_limits<T>::max();
+    return to_integer<T>(f.negative, f.mantissa, f.exponent - 23, rounding);
+}
+
+template <std::integral T> requires (!std::same_as<T, bool>)
+constexpr TinyFloat::operator T() const {
+    return to_integer<T>(*this);
+}
+
+constexpr TinyFloat TinyFloat::from_bits(uint32_t u) {
+    TINYFLOAT_SCOPE(convert);
+    Tallied<uint32_t> word = u;
+    Tallied<uint32_t> sign_bit     = (word >> 31) % 2;
+    Tallied<uint32_t> raw_exponent = (word >> 23) % 256;
+    Tallied<uint32_t> raw_mantissa =  word % (1u<<23);
+
+    TinyFloat f(sign_bit, raw_exponent - 127, raw_mantissa);
+    if (f.exponent==-127) // zero or subnormal
+        f.exponent++;
+    else if (f.exponent<128) // normal, recover the hidden bit = 1
+        f.mantissa = raw_mantissa + (1u<<23);
+    return f;
+}
+
+constexpr uint32_t TinyFloat::bits() const {
+    TINYFLOAT_SCOPE(convert);
+    Tallied<uint32_t> sign_bit = negative;
+    Tallied<uint32_t> raw_exponent = exponent+127;
+    Tallied<uint32_t> raw_mantissa = mantissa % (1u<<23); // clear the hidden bit
+    if (exponent==-126 && mantissa<(1u<<23))
+        raw_exponent = 0; // zero or subnormal
+    return (sign_bit<<31) + (raw_exponent<<23) + raw_mantissa;
+}
+
+// mantissa * 2^exponent rounded to nearest, even on ties, LSB may be sticky: the last step of the parser,
+// the exact accumulator and the elementary functions
+constexpr TinyFloat round_to_tinyfloat(bool negative, Tallied<int> exponent, Tallied<uint64_t> mantissa) {
+    if (!mantissa)
+        return TinyFloat::zero(negative);
+
+    Tallied<int> e = 63 - tinyfloat_clz(mantissa) + exponent;
+    e = e > -126 ? e : Tallied<int>(-126);
+    Tallied<int> lsb = e - 23 - exponent;
+    Tallied<uint64_t> m = 0;
+    bool up = false;
+    if (lsb <= 0)                                // exact
+        m = mantissa << -lsb;
+    else if (lsb < 64) {
+        m = mantissa >> lsb;
+        Tallied<uint64_t> remainder = mantissa & ((1ull<<lsb) - 1), half = 1ull<<(lsb-1);
+        up = remainder > half || (remainder == half && m % 2);
+    }
+    else if (lsb == 64)                          // the mantissa is all remainder, half is 2^63 and the tie goes to 0
+        up = mantissa > (1ull<<63);
+    TINYFLOAT_TALLY(rounding, up);
+    if (up && ++m == (1u<<24)) {                 // renormalize if necessary
+        m /= 2;
+        e++;
+    }
+    if (e >= 128)
+        return TinyFloat::inf(negative);
+    return { negative, int16_t(e), uint32_t(m) };
+}
+
+constexpr bool operator==(const TinyFloat& lhs, const TinyFloat& rhs) {
+    TINYFLOAT_SCOPE(compare);
+    if (lhs.isnan() || rhs.isnan()) return false;  // NaNs are unordered
+    if (lhs.isfinite() && rhs.isfinite() && !lhs.mantissa && !rhs.mantissa) return true; // +0 = -0
+    return lhs.mantissa == rhs.mantissa && lhs.exponent == rhs.exponent && lhs.negative == rhs.negative;
+}
+
+constexpr bool operator!=(const TinyFloat& lhs, const TinyFloat& rhs) {
+    TINYFLOAT_SCOPE(compare);
+    return !(lhs == rhs);
+}
+
+constexpr bool operator<(const TinyFloat& lhs, const TinyFloat& rhs) {
+    TINYFLOAT_SCOPE(compare);
+    if (lhs.isnan() || rhs.isnan() || lhs==rhs) return false;
+    if (lhs.negative != rhs.negative)      // positive > negative
+        return lhs.negative;
+    return lhs.negative !=                 // same sign and not equal
+        ((lhs.exponent <  rhs.exponent) || // => check exponents and then mantissas
+         (lhs.exponent == rhs.exponent && lhs.mantissa < rhs.mantissa));
+}
+
+constexpr bool operator>(const TinyFloat& lhs, const TinyFloat& rhs) {
+    TINYFLOAT_SCOPE(compare);
+    if (lhs.isnan() || rhs.isnan()) return false; // NaNs are unordered
+    return !(lhs<rhs || lhs==rhs);
+}
+
+constexpr bool operator<=(const TinyFloat& lhs, const TinyFloat& rhs) {
+    TINYFLOAT_SCOPE(compare);
+    return lhs<rhs || lhs==rhs;
+}
+
+constexpr bool operator>=(const TinyFloat& lhs, const TinyFloat& rhs) {
+    TINYFLOAT_SCOPE(compare);
+    return lhs>rhs || lhs==rhs;
+}
+
+constexpr TinyFloat operator+(const TinyFloat &lhs, const TinyFloat &rhs) {
+    TINYFLOAT_SCOPE(add);
+    TinyFloat a = lhs.exponent < rhs.exponent ? rhs : lhs; // a has the largest exponent,
+    TinyFloat b = lhs.exponent < rhs.exponent ? lhs : rhs; // the special cases below are symmetric
+    TINYFLOAT_COUNT(add, special, !a.isfinite() || !b.isfinite() || (!a.mantissa && !b.mantissa));
+
+    if (a.isnan() || b.isnan())
+        return TinyFloat::nan();
+    if (a.isinf() && b.isinf()) {
+        if (a.negative == b.negative) return a; // same sign infinity
+        return TinyFloat::nan();                // inf + -inf = nan
+    }
+    if (a.isinf()) return a;
+    if (b.isinf()) return b;
+
+    if (!a.mantissa && !b.mantissa)                       // handle zeros
+        return TinyFloat::zero(a.negative && b.negative); // if signs differ, result is +0
+    TINYFLOAT_COUNT(add, subnormal, a.mantissa < (1u<<23) || b.mantissa < (1u<<23));
+
+    a.mantissa *= 8;                                  // reserve place for GRS bits
+    b.mantissa *= 8;
+
+    Tallied<int> shift = a.exponent - b.exponent;     // align exponents with a single shift
+    TINYFLOAT_COUNT(add, iterations, shift < 27 ? int(shift) : 27);
+    if (shift >= 27)                                  // b is entirely below the sticky bit
+        b.mantissa = b.mantissa != 0;
+    else if (shift > 0)                               // LSB is sticky
+        b.mantissa = (b.mantissa >> shift) | ((b.mantissa & ((1u<<shift) - 1)) != 0);
+
+    TinyFloat sum = { a.mantissa >= b.mantissa ? a.negative : b.negative, a.exponent, 0 };
+
+    if (a.negative == b.negative)
+        sum.mantissa = a.mantissa + b.mantissa;
+    else
+        if (a.mantissa >= b.mantissa)
+            sum.mantissa = a.mantissa - b.mantissa;
+        else
+            sum.mantissa = b.mantissa - a.mantissa;
+
+    Tallied<int> lz = tinyfloat_clz(sum.mantissa) - 5; // normalize the result: the leading bit goes to position 23+3,
+    if (lz > 0) {                                      // but the exponent can not go below -126
+        lz = lz < sum.exponent + 126 ? lz : sum.exponent + 126;
+        sum.mantissa <<= lz;
+        sum.exponent -= lz;
+        TINYFLOAT_COUNT(add, iterations, lz);
+    }
+
+    if (sum.mantissa >= (1u<<(24+3))) {                     // at most one bit of carry
+        sum.mantissa = (sum.mantissa/2) | (sum.mantissa%2); // do not forget the sticky bit
+        sum.exponent++;
+    }
+
+    Tallied<uint32_t> g = (sum.mantissa / 4) % 2; // guard bit
+    Tallied<uint32_t> r = (sum.mantissa / 2) % 2; // round bit
+    Tallied<uint32_t> s =  sum.mantissa % 2;      // sticky bit
+    sum.mantissa /= 8;
+
+    if (g && (r || s || (sum.mantissa % 2))) { // round-to-nearest, even-on-ties
+        TINYFLOAT_COUNT(add, rounding, 1);
+        sum.mantissa++;
+        if (sum.mantissa == (1u<<24)) {        // renormalize if necessary
+            sum.mantissa /= 2;
+            sum.exponent++;
+        }
+    }
+
+    if (sum.exponent >= 128)               // handle overflow
+        return TinyFloat::inf(sum.negative);
+
+    if (!sum.mantissa)                     // When the sum of two operands with opposite signs (or the difference of two operands with like signs)
+        return TinyFloat::zero();          // is exactly zero, the sign of that sum (or difference) shall be +0
+    return sum;
+}
+
+constexpr TinyFloat operator-(const TinyFloat &lhs, const TinyFloat &rhs) {
+    TinyFloat f(!rhs.negative, rhs.exponent, rhs.mantissa);
+    return lhs + f;
+}
+
+constexpr TinyFloat operator*(const TinyFloat &lhs, const TinyFloat &rhs) {
+    TINYFLOAT_SCOPE(mul);
+    TinyFloat a = lhs;
+    TinyFloat b = rhs;
+    TINYFLOAT_COUNT(mul, special, !a.isfinite() || !b.isfinite() || !a.mantissa || !b.mantissa);
+    if (a.isnan() || b.isnan())
+        return TinyFloat::nan();
+    if (a.isinf() || b.isinf()) {
+        if ((a.isfinite() && !a.mantissa) || (b.isfinite() && !b.mantissa)) // inf * 0 = nan
+            return TinyFloat::nan();
+        return TinyFloat::inf(a.negative != b.negative);
+    }
+    if (!a.mantissa || !b.mantissa)
+        return TinyFloat::zero(a.negative != b.negative);
+
+    Tallied<int16_t> exponent = a.exponent + b.exponent + 1; // +1 comes from the separation of a.mantissa * b.mantissa into two 24-bit variables
+    bool negative = a.negative != b.negative;
+
+    Tallied<uint32_t> a_hi = a.mantissa / (1u<<12);  // multiply 2 24-bit mantissas
+    Tallied<uint32_t> a_lo = a.mantissa % (1u<<12);  // into two 24-bit halves mantissa, mantissa_low
+    Tallied<uint32_t> b_hi = b.mantissa / (1u<<12);
+    Tallied<uint32_t> b_lo = b.mantissa % (1u<<12);
+    Tallied<uint32_t> hihi = a_hi * b_hi;
+    Tallied<uint32_t> hilo = a_hi * b_lo;
+    Tallied<uint32_t> lohi = a_lo * b_hi;
+    Tallied<uint32_t> lolo = a_lo * b_lo;
+    Tallied<uint32_t> mantissa_low = lolo + (hilo % (1u<<12) + lohi % (1u<<12)) * (1u<<12);
+    Tallied<uint32_t> mantissa = hihi +  hilo / (1u<<12) + lohi / (1u<<12) + mantissa_low/(1u<<24);
+    mantissa_low = mantissa_low % (1u<<24);
+
+    TINYFLOAT_COUNT(mul, subnormal, a.mantissa < (1u<<23) || b.mantissa < (1u<<23) || exponent < -126);
+    while (mantissa < (1u<<23) && exponent > -126) { // normalize the result
+        TINYFLOAT_COUNT(mul, iterations, 1);
+        mantissa = mantissa * 2 + mantissa_low / (1u<<23);
+        mantissa_low = (mantissa_low * 2) % (1u<<24);
+        exponent--;
+    }
+
+    while (exponent < -126) {
+        TINYFLOAT_COUNT(mul, iterations, 1);
+        mantissa_low = ((mantissa_low + (mantissa % 2) * (1u<<24))/2) | (mantissa_low % 2); // LSB is sticky
+        mantissa /= 2;
+        exponent++;
+    }
+
+    if (mantissa_low / (1u<<23) && (mantissa_low % (1u<<23) || mantissa % 2)) { // round-to-nearest, even-on-ties
+        TINYFLOAT_COUNT(mul, rounding, 1);
+        mantissa++;
+        if (mantissa == (1u<<24)) {    // renormalize if necessary
+            mantissa /= 2;
+            exponent++;
+        }
+    }
+
+    if (exponent >= 128)               // handle overflow
+        return TinyFloat::inf(negative);
+
+    return { negative, exponent, mantissa };
+}
+
+constexpr TinyFloat operator/(const TinyFloat &a, const TinyFloat &b) {
+    TINYFLOAT_SCOPE(div);
+    bool a_zero = a.isfinite() && !a.mantissa;
+    bool b_zero = b.isfinite() && !b.mantissa;
+    TINYFLOAT_COUNT(div, special, !a.isfinite() || !b.isfinite() || a_zero || b_zero);
+    if (a.isnan() || b.isnan() || (a.isinf() && b.isinf()) || (a_zero && b_zero))
+        return TinyFloat::nan();
+
+    bool negative = a.negative != b.negative;
+    if (a.isinf() || b_zero)
+        return TinyFloat::inf(negative);
+
+    if (a_zero || b.isinf())
+        return TinyFloat::zero(negative);
+
+    Tallied<uint32_t> a_mantissa = a.mantissa, b_mantissa = b.mantissa;
+    Tallied<int> exponent = a.exponent - b.exponent;
+    Tallied<int> a_lz = tinyfloat_clz(a_mantissa) - 8; // normalize subnormals
+    Tallied<int> b_lz = tinyfloat_clz(b_mantissa) - 8;
+    a_mantissa <<= a_lz;
+    b_mantissa <<= b_lz;
+    exponent += b_lz - a_lz;
+    if (a_mantissa < b_mantissa) {                     // the quotient is in [1, 2)
+        a_mantissa *= 2;
+        exponent--;
+    }
+
+    Tallied<uint32_t> mantissa  = 1;                   // the leading bit of the quotient
+    Tallied<uint32_t> remainder = a_mantissa - b_mantissa;
+    for (Tallied<int> i=0; i<3; i++) {                 // radix-256 long division: 8 quotient bits per step,
+        TINYFLOAT_COUNT(div, iterations, 1);
+        remainder *= 256;                              // the remainder is below 2^24, so no overflow
+        Tallied<uint32_t> digit = remainder / b_mantissa;
+        mantissa = mantissa * 256 + digit;
+        remainder -= digit * b_mantissa;               // a multiply-subtract, cheaper than a second division
+    }
+    mantissa = mantissa * 2 + (remainder != 0);        // 24 bits + guard bit + sticky bit
+
+    TINYFLOAT_COUNT(div, subnormal, a_lz > 0 || b_lz > 0 || exponent < -126);
+    if (exponent < -126) {                             // denormalize, LSB is sticky
+        Tallied<int> shift = -126 - exponent;
+        mantissa = shift >= 26 ? Tallied<uint32_t>(mantissa != 0) : (mantissa >> shift) | ((mantissa & ((1u<<shift) - 1)) != 0);
+        exponent = -126;
+    }
+
+    Tallied<uint32_t> g = (mantissa / 2) % 2;          // guard bit
+    Tallied<uint32_t> s =  mantissa % 2;               // sticky bit
+    mantissa /= 4;
+
+    if (g && (s || (mantissa % 2))) {                  // round-to-nearest, even-on-ties
+        TINYFLOAT_COUNT(div, rounding, 1);
+        mantissa++;
+        if (mantissa == (1u<<24)) {                    // renormalize if necessary
+            mantissa /= 2;
+            exponent++;
+        }
+    }
+
+    if (exponent >= 128)                               // handle overflow
+        return TinyFloat::inf(negative);
+
+    return { negative, int16_t(exponent), mantissa };
+}
+
+constexpr TinyFloat operator-(const TinyFloat &f) {
+    if (f.isnan()) return f;
+    return { !f.negative, f.exponent, f.mantissa };
+}
+
+constexpr TinyFloat fma(const TinyFloat &a, const TinyFloat &b, const TinyFloat &c) { // a*b + c with a single rounding
+    TINYFLOAT_SCOPE(fma);
+    TINYFLOAT_COUNT(fma, special, !a.isfinite() || !b.isfinite() || !c.isfinite()); // zero operands are counted by operator+ or operator*
+    if (a.isnan() || b.isnan() || c.isnan())
+        return TinyFloat::nan();
+    bool negative = a.negative != b.negative;  // sign of the product
+    if (a.isinf() || b.isinf()) {
+        if ((a.isfinite() && !a.mantissa) || (b.isfinite() && !b.mantissa) || (c.isinf() && c.negative != negative))
+            return TinyFloat::nan();           // inf * 0 = nan, inf - inf = nan
+        return TinyFloat::inf(negative);
+    }
+    if (c.isinf()) return c;
+    if (!a.mantissa || !b.mantissa)            // the product is an exact zero
+        return TinyFloat::zero(negative) + c;
+    if (!c.mantissa)                           // nothing to add, a*b is rounded once
+        return a * b;
+
+    Tallied<uint32_t> a_hi = a.mantissa / (1u<<12); // multiply 2 24-bit mantissas
+    Tallied<uint32_t> a_lo = a.mantissa % (1u<<12); // into a 48-bit product, no bit is lost
+    Tallied<uint32_t> b_hi = b.mantissa / (1u<<12);
+    Tallied<uint32_t> b_lo = b.mantissa % (1u<<12);
+    Tallied<uint32_t> hihi = a_hi * b_hi;
+    Tallied<uint32_t> hilo = a_hi * b_lo;
+    Tallied<uint32_t> lohi = a_lo * b_hi;
+    Tallied<uint32_t> lolo = a_lo * b_lo;
+    Tallied<uint64_t> product = (Tallied<uint64_t>(hihi) << 24) + (Tallied<uint64_t>(hilo + lohi) << 12) + lolo;
+
+    bool              xneg = negative,                    yneg = c.negative;     // x = xman * 2^xexp is the product,
+    Tallied<int>      xexp = a.exponent + b.exponent - 46, yexp = c.exponent - 23; // y = yman * 2^yexp is the addend
+    Tallied<uint64_t> xman = product,                     yman = c.mantissa;
+
+    Tallied<int> xlz = tinyfloat_clz(xman) - 2; // move the leading bits to position 61,
+    Tallied<int> ylz = tinyfloat_clz(yman) - 2; // it leaves room for the carry
+    xman <<= xlz;
+    xexp  -= xlz;
+    yman <<= ylz;
+    yexp  -= ylz;
+
+    if (xexp < yexp || (xexp == yexp && xman < yman)) { // x is the largest in magnitude
+        bool              n = xneg; xneg = yneg; yneg = n;
+        Tallied<int>      e = xexp; xexp = yexp; yexp = e;
+        Tallied<uint64_t> m = xman; xman = yman; yman = m;
+    }
+
+    Tallied<int> shift = xexp - yexp;          // align exponents, LSB is sticky
+    TINYFLOAT_COUNT(fma, iterations, shift < 63 ? int(shift) : 63);
+    if (shift >= 63)
+        yman = 1;
+    else if (shift > 0)
+        yman = (yman >> shift) | ((yman & ((1ull<<shift) - 1)) != 0);
+
+    Tallied<uint64_t> sum = xneg == yneg ? xman + yman : xman - yman;
+    if (!sum)                                  // exact cancellation gives +0
+        return TinyFloat::zero();
+
+    TinyFloat result = round_to_tinyfloat(xneg, xexp, sum); // a single rounding of the exact sum
+    TINYFLOAT_COUNT(fma, subnormal, a.mantissa < (1u<<23) || b.mantissa < (1u<<23) || c.mantissa < (1u<<23) || result.exponent == -126);
+    return result;
+}
+
+constexpr TinyFloat sqrt(const TinyFloat &f) { // correctly rounded, digit-by-digit
+    TINYFLOAT_SCOPE(sqrt);
+    TINYFLOAT_COUNT(sqrt, special, f.isnan() || f.negative || f.isinf() || !f.mantissa);
+    if (f.isnan() || f < TinyFloat::zero())     // sqrt of a negative number is nan
+        return TinyFloat::nan();
+    if (f.isinf() || !f.mantissa)              // sqrt(+inf) = +inf, sqrt(-0) = -0
+        return f;
+
+    Tallied<int> exponent = f.exponent;
+    Tallied<uint32_t> mantissa = f.mantissa;
+    Tallied<int> lz = tinyfloat_clz(mantissa) - 8; // normalize subnormals
+    mantissa <<= lz;
+    exponent -= lz;
+    TINYFLOAT_COUNT(sqrt, subnormal, lz > 0);
+
+    Tallied<uint64_t> remainder = Tallied<uint64_t>(mantissa) << (23 + (exponent & 1)); // the exponent must be even
+    Tallied<uint64_t> root = 0;
+    for (Tallied<uint64_t> bit = 1ull<<46; bit; bit /= 4) { // integer square root of a 48-bit number
+        TINYFLOAT_COUNT(sqrt, iterations, 1);
+        if (remainder >= root + bit) {
+            remainder -= root + bit;
+            root = root/2 + bit;
+        } else
+            root /= 2;
+    }
+    exponent = (exponent - (exponent & 1)) / 2;
 
-bool operator==(const TinyFloat& lhs, const TinyFloat& rhs);
-bool operator!=(const TinyFloat& lhs, const TinyFloat& rhs);
-bool operator<=(const TinyFloat& lhs, const TinyFloat& rhs);
-bool operator>=(const TinyFloat& lhs, const TinyFloat& rhs);
-bool operator< (const TinyFloat& lhs, const TinyFloat& rhs);
-bool operator> (const TinyFloat& lhs, const TinyFloat& rhs);
+    if (remainder > root) {                    // round-to-nearest, ties are impossible
+        TINYFLOAT_COUNT(sqrt, rounding, 1);
+        root++;
+        if (root == (1u<<24)) {                // renormalize if necessary
+            root /= 2;
+            exponent++;
+        }
+    }
 
-TinyFloat operator+(const TinyFloat &lhs, const TinyFloat &rhs);
-TinyFloat operator-(const TinyFloat &lhs, const TinyFloat &rhs);
-TinyFloat operator*(const TinyFloat &lhs, const TinyFloat &rhs);
-TinyFloat operator/(const TinyFloat &lhs, const TinyFloat &rhs);
-TinyFloat operator-(const TinyFloat &f);
+    return { false, int16_t(exponent), uint32_t(root) };
+}
 